@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBinaryImageToBitPackedImageFilter_h
+#define itkBinaryImageToBitPackedImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include <cstdint>
+
+namespace itk
+{
+
+/** \class BinaryImageToBitPackedImageFilter
+ *
+ * \brief Pack a binary image into 64 pixels per word along the first
+ * dimension.
+ *
+ * Each pixel of the output holds 64 consecutive pixels of a line of
+ * the input, the least significant bit is the lowest index. Any
+ * non-zero input pixel is a set bit. Word w of a line holds the input
+ * pixels with index 64*w to 64*w+63, so the output largest possible
+ * region is the input's divided by 64 along the first dimension
+ * rounded outwards. Bits for indexes outside of the input are zero.
+ *
+ * The output spacing along the first dimension is 64 times the
+ * input's, and the origin is shifted along the first direction so the
+ * center of each word is at the center of the 64 pixels it holds.
+ *
+ * \sa BitPackedBoundingRegionImageSinc
+ * \ingroup StreamingSinc
+ **/
+template< class TInputImage >
+class BinaryImageToBitPackedImageFilter
+  : public ImageToImageFilter< TInputImage, Image< std::uint64_t, TInputImage::ImageDimension > >
+{
+public:
+  /** Standard class typedefs. */
+  typedef BinaryImageToBitPackedImageFilter                            Self;
+  typedef Image< std::uint64_t, TInputImage::ImageDimension >          OutputImageType;
+  typedef ImageToImageFilter< TInputImage, OutputImageType >           Superclass;
+  typedef SmartPointer< Self >                                         Pointer;
+  typedef SmartPointer< const Self >                                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BinaryImageToBitPackedImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                              InputImageType;
+  typedef typename InputImageType::RegionType      InputImageRegionType;
+  typedef typename OutputImageType::RegionType     OutputImageRegionType;
+  typedef typename OutputImageType::PixelType      WordType;
+
+  itkStaticConstMacro(WordBits, unsigned int, 64);
+
+  /** The index of the word which holds the pixel at index x along the
+   * first dimension. */
+  static IndexValueType WordIndex( IndexValueType x )
+    {
+      return ( x >= 0 ) ? x / IndexValueType(WordBits) : -( ( -x + IndexValueType(WordBits) - 1 ) / IndexValueType(WordBits) );
+    }
+
+protected:
+  BinaryImageToBitPackedImageFilter() {}
+  ~BinaryImageToBitPackedImageFilter() {}
+
+  void GenerateOutputInformation() ITK_OVERRIDE;
+
+  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+  void DynamicThreadedGenerateData( const OutputImageRegionType & outputRegionForThread ) ITK_OVERRIDE;
+
+  /** The input region which is packed into the output region. */
+  InputImageRegionType PackedToInputRegion( const OutputImageRegionType & packedRegion ) const;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(BinaryImageToBitPackedImageFilter);
+};
+
+} // end namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBinaryImageToBitPackedImageFilter.hxx"
+#endif
+
+#endif //itkBinaryImageToBitPackedImageFilter_h
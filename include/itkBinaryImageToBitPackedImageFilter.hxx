@@ -0,0 +1,173 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkBinaryImageToBitPackedImageFilter_hxx
+#define itkBinaryImageToBitPackedImageFilter_hxx
+
+#include "itkBinaryImageToBitPackedImageFilter.h"
+#include "itkImageScanlineIterator.h"
+
+namespace itk
+{
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+BinaryImageToBitPackedImageFilter< TInputImage >
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType *input = this->GetInput();
+  OutputImageType *output = this->GetOutput();
+  if ( !input || !output )
+    {
+    return;
+    }
+
+  const InputImageRegionType & inputRegion = input->GetLargestPossibleRegion();
+
+  OutputImageRegionType outputRegion = inputRegion;
+  if ( inputRegion.GetSize(0) != 0 )
+    {
+    const IndexValueType first = WordIndex( inputRegion.GetIndex(0) );
+    const IndexValueType last = WordIndex( inputRegion.GetUpperIndex()[0] );
+    outputRegion.SetIndex( 0, first );
+    outputRegion.SetSize( 0, last - first + 1 );
+    }
+  output->SetLargestPossibleRegion( outputRegion );
+
+  // Word w holds the input pixels 64w to 64w+63 along the first
+  // dimension, so its center is at the input index 64w+31.5.
+  const typename InputImageType::SpacingType & inputSpacing = input->GetSpacing();
+  typename OutputImageType::SpacingType spacing = inputSpacing;
+  spacing[0] *= WordBits;
+  output->SetSpacing( spacing );
+
+  typename OutputImageType::PointType origin = input->GetOrigin();
+  const double shift = 0.5 * ( WordBits - 1 ) * inputSpacing[0];
+  for ( unsigned int i = 0; i < OutputImageType::ImageDimension; ++i )
+    {
+    origin[i] += input->GetDirection()[i][0] * shift;
+    }
+  output->SetOrigin( origin );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+typename BinaryImageToBitPackedImageFilter< TInputImage >::InputImageRegionType
+BinaryImageToBitPackedImageFilter< TInputImage >
+::PackedToInputRegion( const OutputImageRegionType & packedRegion ) const
+{
+  InputImageRegionType inputRegion = packedRegion;
+  inputRegion.SetIndex( 0, packedRegion.GetIndex(0) * IndexValueType(WordBits) );
+  inputRegion.SetSize( 0, packedRegion.GetSize(0) * WordBits );
+
+  inputRegion.Crop( this->GetInput()->GetLargestPossibleRegion() );
+  return inputRegion;
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+BinaryImageToBitPackedImageFilter< TInputImage >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType *input = const_cast< InputImageType * >( this->GetInput() );
+  if ( !input )
+    {
+    return;
+    }
+
+  input->SetRequestedRegion( this->PackedToInputRegion( this->GetOutput()->GetRequestedRegion() ) );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+BinaryImageToBitPackedImageFilter< TInputImage >
+::DynamicThreadedGenerateData( const OutputImageRegionType & outputRegionForThread )
+{
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  const InputImageType *input = this->GetInput();
+  OutputImageType *output = this->GetOutput();
+
+  const typename InputImageType::PixelType zero = NumericTraits< typename InputImageType::PixelType >::ZeroValue();
+
+  // Every word in the output region holds at least one input pixel,
+  // so both regions have the same lines.
+  ImageScanlineConstIterator< InputImageType > inputIt( input, this->PackedToInputRegion( outputRegionForThread ) );
+  ImageScanlineIterator< OutputImageType > outputIt( output, outputRegionForThread );
+
+  while ( !outputIt.IsAtEnd() )
+    {
+    IndexValueType x = inputIt.GetIndex()[0];
+    IndexValueType wordStart = outputIt.GetIndex()[0] * IndexValueType(WordBits);
+    WordType word = 0;
+
+    while ( !inputIt.IsAtEndOfLine() )
+      {
+      if ( x - wordStart == IndexValueType(WordBits) )
+        {
+        outputIt.Set( word );
+        ++outputIt;
+        word = 0;
+        wordStart += WordBits;
+        }
+
+      if ( inputIt.Get() != zero )
+        {
+        word |= WordType(1) << ( x - wordStart );
+        }
+      ++inputIt;
+      ++x;
+      }
+
+    // the last word, and any words past the end of the input
+    while ( !outputIt.IsAtEndOfLine() )
+      {
+      outputIt.Set( word );
+      word = 0;
+      ++outputIt;
+      }
+
+    inputIt.NextLine();
+    outputIt.NextLine();
+    }
+}
+
+} // end namespace itk
+
+#endif
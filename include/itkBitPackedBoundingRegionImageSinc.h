@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBitPackedBoundingRegionImageSinc_h
+#define itkBitPackedBoundingRegionImageSinc_h
+
+#include "itkBoundingRegionImageSinc.h"
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace itk
+{
+
+/** \class BitPackedBoundingRegionImageSinc
+ *
+ * \brief Compute the bounding region of the set bits of a bit-packed
+ * binary image.
+ *
+ * The input is an image of 64 bit words as produced by
+ * BinaryImageToBitPackedImageFilter. Each line is scanned a word at a
+ * time: zero words are skipped, the first set bit is found by
+ * counting the trailing zeros of the first non-zero word, and the last
+ * set bit by scanning backwards from the end of the line and counting
+ * the leading zeros.
+ *
+ * The resulting region is in the index space of the unpacked image.
+ *
+ * \sa BinaryImageToBitPackedImageFilter
+ * \ingroup StreamingSinc
+ **/
+template< class TPackedImage >
+class BitPackedBoundingRegionImageSinc
+  : public BoundingRegionImageSinc<TPackedImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef BitPackedBoundingRegionImageSinc      Self;
+  typedef BoundingRegionImageSinc< TPackedImage > Superclass;
+  typedef SmartPointer< Self >                  Pointer;
+  typedef SmartPointer< const Self >            ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BitPackedBoundingRegionImageSinc, BoundingRegionImageSinc);
+
+  /** Image type information. */
+  typedef typename Superclass::InputImageType  InputImageType;
+  typedef typename Superclass::RegionType      RegionType;
+  typedef typename InputImageType::PixelType   WordType;
+
+  static_assert( std::is_same< WordType, std::uint64_t >::value,
+                 "BitPackedBoundingRegionImageSinc requires 64 bit words" );
+
+  itkStaticConstMacro(WordBits, unsigned int, 64);
+
+protected:
+  BitPackedBoundingRegionImageSinc() {}
+  ~BitPackedBoundingRegionImageSinc() {}
+
+  /** The word must be non-zero. */
+  static unsigned int CountTrailingZeros( WordType word )
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast< unsigned int >( __builtin_ctzll( word ) );
+#elif defined(_MSC_VER) && defined(_M_X64)
+      unsigned long i;
+      _BitScanForward64( &i, word );
+      return static_cast< unsigned int >( i );
+#else
+      unsigned int n = 0;
+      while ( !( word & 1 ) )
+        {
+        word >>= 1;
+        ++n;
+        }
+      return n;
+#endif
+    }
+
+  /** The word must be non-zero. */
+  static unsigned int CountLeadingZeros( WordType word )
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast< unsigned int >( __builtin_clzll( word ) );
+#elif defined(_MSC_VER) && defined(_M_X64)
+      unsigned long i;
+      _BitScanReverse64( &i, word );
+      return WordBits - 1 - static_cast< unsigned int >( i );
+#else
+      unsigned int n = 0;
+      while ( !( word & ( WordType(1) << ( WordBits - 1 ) ) ) )
+        {
+        word <<= 1;
+        ++n;
+        }
+      return n;
+#endif
+    }
+
+  void ThreadedStreamedGenerateData(const RegionType &inputRegionForChunk) override
+    {
+      typedef ImageScanlineConstIterator< InputImageType > InputConstIteratorType;
+
+      const InputImageType *inputPtr = this->GetInput();
+
+      const SizeValueType lineLength = inputRegionForChunk.GetSize(0);
+
+      typename InputImageType::IndexType lower, upper;
+      for ( unsigned int i = 0; i < InputImageType::ImageDimension; ++i )
+        {
+        lower[i] = NumericTraits< IndexValueType >::max();
+        upper[i] = NumericTraits< IndexValueType >::NonpositiveMin();
+        }
+
+      InputConstIteratorType inputIt(inputPtr, inputRegionForChunk);
+
+      inputIt.GoToBegin();
+      while ( !inputIt.IsAtEnd() )
+        {
+        const typename InputImageType::IndexType lineIndex = inputIt.GetIndex();
+
+        // the words of a line are contiguous in the buffer
+        const WordType *line = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset( lineIndex );
+
+        SizeValueType first = 0;
+        while ( first < lineLength && line[first] == 0 )
+          {
+          ++first;
+          }
+
+        if ( first < lineLength )
+          {
+          SizeValueType last = lineLength - 1;
+          while ( line[last] == 0 )
+            {
+            --last;
+            }
+
+          const IndexValueType firstBit = ( lineIndex[0] + IndexValueType(first) ) * IndexValueType(WordBits)
+            + IndexValueType( CountTrailingZeros( line[first] ) );
+          const IndexValueType lastBit = ( lineIndex[0] + IndexValueType(last) ) * IndexValueType(WordBits)
+            + IndexValueType( WordBits - 1 - CountLeadingZeros( line[last] ) );
+
+          lower[0] = std::min( lower[0], firstBit );
+          upper[0] = std::max( upper[0], lastBit );
+          for ( unsigned int i = 1; i < InputImageType::ImageDimension; ++i )
+            {
+            lower[i] = std::min( lower[i], lineIndex[i] );
+            upper[i] = std::max( upper[i], lineIndex[i] );
+            }
+          }
+
+        inputIt.NextLine();
+        }
+
+      RegionType r;
+      r.SetIndex(lower);
+      for ( unsigned int i = 0; i < InputImageType::ImageDimension; ++i )
+        {
+        if (lower[i] <= upper[i])
+          {
+          r.SetSize(i, upper[i]-lower[i]+1);
+          }
+        else
+          {
+          r.SetSize(i,0);
+          }
+        }
+
+      this->MergeThreadRegion(r);
+    }
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(BitPackedBoundingRegionImageSinc);
+};
+
+} // end namespace itk
+
+#endif //itkBitPackedBoundingRegionImageSinc_h
@@ -18,7 +18,7 @@
 #ifndef itkBoundingRegionImageSinc_h
 #define itkBoundingRegionImageSinc_h
 
-#include "itkImageSink.h"
+#include "itkStreamingImageSinc.h"
 #include "itkImageScanlineIterator.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include <numeric>
@@ -33,12 +33,12 @@ namespace itk
  **/
 template< class TInputImage >
 class BoundingRegionImageSinc
-  : public ImageSink<TInputImage>
+  : public StreamingImageSinc<TInputImage>
 {
 public:
   /** Standard class typedefs. */
   typedef BoundingRegionImageSinc     Self;
-  typedef ImageSink< TInputImage >    Superclass;
+  typedef StreamingImageSinc< TInputImage > Superclass;
   typedef SmartPointer< Self >        Pointer;
   typedef SmartPointer< const Self >  ConstPointer;
 
@@ -46,7 +46,7 @@ public:
   itkNewMacro(Self);
 
   /** Run-time type information (and related methods). */
-  itkTypeMacro(BoundingRegionImageSinc, ImageSink);
+  itkTypeMacro(BoundingRegionImageSinc, StreamingImageSinc);
 
   /** Image type information. */
   typedef typename Superclass::InputImageType       InputImageType;
@@ -126,6 +126,12 @@ protected:
     }
 
 
+  void BeforeStreamedGenerateData( void ) override
+    {
+      m_ThreadRegion = RegionType();
+      Superclass::BeforeStreamedGenerateData();
+    }
+
   void ThreadedStreamedGenerateData(const RegionType &inputRegionForChunk) override
     {
 
@@ -206,6 +212,12 @@ protected:
         }
 
 
+      this->MergeThreadRegion(r);
+    }
+
+  /** Thread safe union of a chunk's bounding region with the total. */
+  void MergeThreadRegion( const RegionType &r )
+    {
       std::lock_guard<std::mutex> mutexHolder(m_Mutex);
       m_ThreadRegion = RegionUnion(m_ThreadRegion, r);
     }
@@ -215,6 +227,34 @@ protected:
       this->GetRegionOutput()->Set(m_ThreadRegion);
 }
 
+  bool SaveStreamedState( std::ostream &os ) const override
+    {
+      for ( unsigned int i = 0; i < InputImageType::ImageDimension; ++i )
+        {
+        os << m_ThreadRegion.GetIndex(i) << " " << m_ThreadRegion.GetSize(i) << "\n";
+        }
+      return bool(os);
+    }
+
+  bool RestoreStreamedState( std::istream &is ) override
+    {
+      RegionType r;
+      for ( unsigned int i = 0; i < InputImageType::ImageDimension; ++i )
+        {
+        IndexValueType index;
+        SizeValueType size;
+        is >> index >> size;
+        r.SetIndex(i, index);
+        r.SetSize(i, size);
+        }
+      if ( !is )
+        {
+        return false;
+        }
+      m_ThreadRegion = r;
+      return true;
+    }
+
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(BoundingRegionImageSinc);
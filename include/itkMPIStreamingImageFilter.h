@@ -23,10 +23,44 @@
 #include "itkExtractImageFilter.h"
 #include "itkPasteImageFilter.h"
 #include <mpi.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace itk
 {
 
+/** \class MPIStreamingImageFilter
+ *
+ * \brief Redistribute the regions of an image between the MPI ranks.
+ *
+ * Each rank requests its own output region, and the input is split
+ * across the ranks with the RegionSplitter. The overlapping parts of
+ * the input regions are sent to the ranks which need them.
+ *
+ * The transfers are non-blocking: the receives are posted first, each
+ * send region is sent as soon as it is extracted, and the local and
+ * received regions are pasted into the output while the remaining
+ * transfers are in progress. With UseCommunicationThread enabled and
+ * MPI initialized with MPI_THREAD_MULTIPLE, a separate thread drives
+ * the receives to completion from the time they are posted, so the
+ * communication progresses while the send regions are extracted and
+ * while the pasting is done with the ITK threads.
+ *
+ * When every rank requests the largest possible region, or
+ * ReplicateOutput is enabled, each rank copies its input region
+ * directly into the output buffer and the regions are gathered in
+ * place with a single MPI_Iallgatherv, without extracting, receiving
+ * or pasting intermediate images. This requires the input regions to
+ * be contiguous in the output buffer, as with the default
+ * ImageRegionSplitterSlowDimension, otherwise the regions are
+ * exchanged as above.
+ *
+ * \ingroup StreamingSinc
+ **/
 template < class TImageType >
 class MPIStreamingImageFilter
   : public ImageToImageFilter< TImageType, TImageType >
@@ -40,6 +74,7 @@ public:
 
   typedef TImageType                     ImageType;
   typedef typename ImageType::RegionType RegionType;
+  typedef typename ImageType::PixelType  PixelType;
 
    /** Method for creation through the object factory. */
   itkNewMacro(Self);
@@ -54,6 +89,45 @@ public:
   itkSetObjectMacro(RegionSplitter, SplitterType);
   itkGetObjectMacro(RegionSplitter, SplitterType);
 
+  /** Set/Get if a separate thread progresses the MPI communication
+   * while the received regions are pasted. This requires MPI to be
+   * initialized with MPI_THREAD_MULTIPLE, otherwise the communication
+   * is progressed by the calling thread. The default is off. */
+  itkSetMacro(UseCommunicationThread, bool);
+  itkGetConstMacro(UseCommunicationThread, bool);
+  itkBooleanMacro(UseCommunicationThread);
+
+  /** Set/Get if every rank produces the largest possible region,
+   * regardless of its requested region. The default is off, but the
+   * output is also replicated when all the ranks request the largest
+   * possible region. */
+  itkSetMacro(ReplicateOutput, bool);
+  itkGetConstMacro(ReplicateOutput, bool);
+  itkBooleanMacro(ReplicateOutput);
+
+  /** The state of an exchange of the regions between the ranks. It
+   * is kept alive by the handle of a split-phase update, and is opaque
+   * except for its statistics. */
+  class ExchangeType;
+
+  typedef std::shared_ptr< ExchangeType > UpdateHandleType;
+
+  /** Start a split-phase update. The pipeline is updated up to this
+   * filter and the exchange between the ranks is posted, then the
+   * handle of the pending exchange is returned. The caller may do other
+   * work, such as updating the input for the next time step, before
+   * completing the exchange with FinishUpdate. The regions sent are
+   * copies, so the input may change while the exchange is pending.
+   *
+   * The output of the filter is not updated by a split-phase update,
+   * the result is returned by FinishUpdate instead. Every handle must
+   * be finished, in the same order on all the ranks. */
+  UpdateHandleType StartUpdate( void );
+
+  /** Wait for the exchange of a split-phase update, and return the
+   * completed image, which is disconnected from the pipeline. */
+  typename ImageType::Pointer FinishUpdate( UpdateHandleType handle );
+
 protected:
   MPIStreamingImageFilter();
   ~MPIStreamingImageFilter();
@@ -68,6 +142,19 @@ protected:
 
   virtual void GenerateData() ITK_OVERRIDE;
 
+  /** Post the transfers, and paste the local input region into the
+   * Working image of the exchange. */
+  void StartExchange( ExchangeType &exchange );
+
+  /** Paste the received regions as the transfers complete, and wait
+   * for the sends. */
+  void FinishExchange( ExchangeType &exchange );
+
+  /** Returns true if all the ranks request the largest possible
+   * region, and the input regions can be gathered in place into the
+   * output buffer. */
+  bool CanReplicateInPlace( void ) const;
+
   static MPI_Datatype GetMPIDataTypeForPixel()
     {
 
@@ -96,10 +183,28 @@ protected:
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(MPIStreamingImageFilter);
 
+  typename ImageType::Pointer ExtractSendImage( const ImageType *input, const RegionType &region );
+
+  void StartProgressThread( ExchangeType &exchange );
+
+  static void ProgressExchange( ExchangeType *exchange );
+
+  void PasteIntoWorking( ExchangeType &exchange, const ImageType *source, const RegionType &region );
+
+  void StartReplicateExchange( ExchangeType &exchange );
+
   int m_MPITAG;
   int m_MPIRank;
   int m_MPISize;
 
+  bool m_UseCommunicationThread;
+  bool m_ReplicateOutput;
+  bool m_ReplicateInPlace;
+
+  // state of StartUpdate
+  bool             m_SplitPhase;
+  UpdateHandleType m_PendingExchange;
+
   const MPI_Datatype m_MPIDataType;
 
   std::vector< RegionType > m_MPIOutputRegions;
@@ -108,6 +213,74 @@ private:
   typename SplitterType::Pointer m_RegionSplitter;
 };
 
+
+template < class TImageType >
+class MPIStreamingImageFilter< TImageType >::ExchangeType
+{
+public:
+  ExchangeType() : NumberOfReceives(0), NumberOfBytesSent(0), NumberOfBytesReceived(0) {}
+
+  /** Completes the pending transfers, as their buffers are owned by
+   * the exchange. */
+  ~ExchangeType()
+    {
+      if ( ProgressThread.joinable() )
+        {
+        ProgressThread.join();
+        }
+
+      int finalized = 0;
+      MPI_Finalized( &finalized );
+      if ( finalized )
+        {
+        return;
+        }
+      if ( !Requests.empty() )
+        {
+        MPI_Waitall( static_cast< int >( Requests.size() ), &Requests[0], MPI_STATUSES_IGNORE );
+        }
+      if ( !SendRequests.empty() )
+        {
+        MPI_Waitall( static_cast< int >( SendRequests.size() ), &SendRequests[0], MPI_STATUSES_IGNORE );
+        }
+    }
+
+  /** The number of bytes of the regions sent to and received from
+   * the other ranks. */
+  SizeValueType GetNumberOfBytesSent( void ) const { return NumberOfBytesSent; }
+  SizeValueType GetNumberOfBytesReceived( void ) const { return NumberOfBytesReceived; }
+
+private:
+  friend class MPIStreamingImageFilter< TImageType >;
+
+  typename ImageType::Pointer                Working;
+  std::vector< RegionType >                  RecvRegions;
+  std::vector< typename ImageType::Pointer > RecvImages;
+  std::vector< typename ImageType::Pointer > SendImages;
+
+  /** The pending receives and the rank received by each, or -1 for
+   * the gather. They are driven by the progress thread. */
+  std::vector< MPI_Request > Requests;
+  std::vector< int >         RequestSplits;
+  size_t                     NumberOfReceives;
+
+  /** The pending sends, which are posted after the progress thread
+   * is started. */
+  std::vector< MPI_Request > SendRequests;
+
+  SizeValueType              NumberOfBytesSent;
+  SizeValueType              NumberOfBytesReceived;
+
+  /** The counts and displacements of the in place gather. */
+  std::vector< int >         Counts;
+  std::vector< int >         Displacements;
+
+  std::thread                ProgressThread;
+  std::mutex                 Mutex;
+  std::condition_variable    ReceiveCompleted;
+  std::deque< int >          CompletedReceives;
+};
+
 } // end namespace itk
 
 
@@ -20,6 +20,7 @@
 #define itkMPIStreamingImageFilter_hxx
 
 #include "itkMPIStreamingImageFilter.h"
+#include "itkImageAlgorithm.h"
 
 namespace itk
 {
@@ -30,7 +31,11 @@ namespace itk
 template < class TImageType >
 MPIStreamingImageFilter< TImageType >
 ::MPIStreamingImageFilter()
-  : m_MPIDataType(GetMPIDataTypeForPixel())
+  : m_UseCommunicationThread(false),
+    m_ReplicateOutput(false),
+    m_ReplicateInPlace(false),
+    m_SplitPhase(false),
+    m_MPIDataType(GetMPIDataTypeForPixel())
 {
   m_MPITAG = 99;
 
@@ -84,6 +89,11 @@ MPIStreamingImageFilter< TImageType >
   if ( output )
     {
 
+    if ( m_ReplicateOutput )
+      {
+      output->SetRequestedRegionToLargestPossibleRegion();
+      }
+
     this->m_MPIOutputRegions.resize( m_MPISize );
 
     // share the output requested region will all processes
@@ -189,6 +199,8 @@ MPIStreamingImageFilter< TImageType >
     return;
     }
 
+  m_ReplicateInPlace = this->CanReplicateInPlace();
+
   itkDebugMacro( "RANK " << m_MPIRank << " requested region: " << m_MPIInputRegions[ m_MPIRank ] );
 
   input->SetRequestedRegion( m_MPIInputRegions[ m_MPIRank ] );
@@ -203,15 +215,113 @@ void
 MPIStreamingImageFilter< TImageType >
 ::GenerateData()
 {
+  if ( m_SplitPhase )
+    {
+    // exchange into a new image, so the previous results are not
+    // overwritten while the exchange is pending
+    const ImageType * output = this->GetOutput();
+    m_PendingExchange = std::make_shared< ExchangeType >();
+    m_PendingExchange->Working = ImageType::New();
+    m_PendingExchange->Working->CopyInformation( output );
+    m_PendingExchange->Working->SetBufferedRegion( output->GetRequestedRegion() );
+    m_PendingExchange->Working->SetRequestedRegion( output->GetRequestedRegion() );
+    m_PendingExchange->Working->Allocate();
+
+    this->StartExchange( *m_PendingExchange );
+    return;
+    }
+
   this->AllocateOutputs();
 
+  ExchangeType exchange;
+  exchange.Working = ImageType::New();
+  exchange.Working->Graft( this->GetOutput() );
+
+  this->StartExchange( exchange );
+  this->FinishExchange( exchange );
+
+  exchange.Working->SetLargestPossibleRegion( this->GetInput()->GetLargestPossibleRegion() );
+  this->GraftOutput( exchange.Working );
+}
+
+
+/**
+ *
+ */
+template < class TImageType >
+typename MPIStreamingImageFilter< TImageType >::UpdateHandleType
+MPIStreamingImageFilter< TImageType >
+::StartUpdate()
+{
+  // always execute, as the exchange is into a new image
+  this->Modified();
+
+  m_SplitPhase = true;
+  try
+    {
+    this->Update();
+    }
+  catch ( ... )
+    {
+    m_SplitPhase = false;
+    m_PendingExchange.reset();
+    throw;
+    }
+  m_SplitPhase = false;
+
+  // the output was not generated, so the next update must execute
+  this->Modified();
+
+  UpdateHandleType handle;
+  handle.swap( m_PendingExchange );
+  return handle;
+}
+
+
+/**
+ *
+ */
+template < class TImageType >
+typename MPIStreamingImageFilter< TImageType >::ImageType::Pointer
+MPIStreamingImageFilter< TImageType >
+::FinishUpdate( UpdateHandleType handle )
+{
+  if ( !handle || !handle->Working )
+    {
+    itkExceptionMacro( "Invalid update handle" );
+    }
+
+  this->FinishExchange( *handle );
+
+  typename ImageType::Pointer result = handle->Working;
+  result->DisconnectPipeline();
+
+  // the handle can not be finished twice
+  handle->Working = nullptr;
+  return result;
+}
+
+
+/**
+ *
+ */
+template < class TImageType >
+void
+MPIStreamingImageFilter< TImageType >
+::StartExchange( ExchangeType &exchange )
+{
+  if ( m_ReplicateInPlace )
+    {
+    this->StartReplicateExchange( exchange );
+    return;
+    }
+
   const ImageType *  input = this->GetInput();
 
   // compute regions to send
   // this is the intersection of out input region with each output
   // region
   std::vector< RegionType > sendRegions( m_MPISize );
-  std::vector< typename ImageType::Pointer > sendImages( m_MPISize );
   for ( int split = 0; split < m_MPISize; ++split )
     {
     sendRegions[ split ] = m_MPIInputRegions[ m_MPIRank ];
@@ -224,67 +334,13 @@ MPIStreamingImageFilter< TImageType >
       s.Fill( 0 );
       sendRegions[ split ].SetSize( s );
       }
-
-    typedef itk::ExtractImageFilter< ImageType, ImageType > ExtractorType;
-    if ( sendRegions[ split ].GetNumberOfPixels() != 0 )
-      {
-
-      // check if we can reuse an extracted image
-      for ( int i = 0; i < split; ++i )
-        {
-        if ( sendImages[i] && sendImages[i]->GetLargestPossibleRegion() == sendRegions[ split ] )
-          {
-          sendImages[split] = sendImages[i];
-          }
-        }
-
-      // if we didn't reuse the image, then extract it
-      if ( !sendImages[split] )
-        {
-        typename ExtractorType::Pointer extractor = ExtractorType::New();
-        extractor->SetInput( input );
-        extractor->SetExtractionRegion( sendRegions[ split ] );
-        extractor->SetDirectionCollapseToIdentity();
-        try
-          {
-          extractor->Update();
-          }
-        catch ( itk::ExceptionObject  & e )
-          {
-          std::cerr << "RANK " << m_MPIRank << std::endl;
-          std::cerr << "Excpetion caught while exracting send region!" << std::endl;
-          std::cerr << e << std::endl;
-          }
-
-        sendImages[split] = extractor->GetOutput();
-        }
-      }
-    } // end for split
-
-  //  check if all send Images are the same and not null, except the
-  //  rank's send image
-  int useBcastLocal = sendImages[(m_MPIRank+1)%m_MPISize].IsNotNull();
-  for ( int split = 0; split < m_MPISize-1; ++split )
-    {
-    if ( split == m_MPIRank )
-      continue;
-
-    int nextSplit = split + 1;
-
-    if ( m_MPIRank == nextSplit )
-      {
-      nextSplit = ( nextSplit + 1 ) % m_MPISize;
-      }
-
-    useBcastLocal &= ( sendImages[split] == sendImages[nextSplit] );
     }
 
-  std::vector< int > useBcast( m_MPISize );
-  MPI_Allgather( &useBcastLocal, 1, MPI_INT, &(useBcast[0]), 1, MPI_INT, MPI_COMM_WORLD );
-
-
-  std::vector< RegionType > recvRegions( m_MPISize );
-  std::vector< typename ImageType::Pointer > recvImages( m_MPISize );
+  // compute the regions to receive
+  // this is the intersection of our output region with each input
+  // region
+  std::vector< RegionType > & recvRegions = exchange.RecvRegions;
+  recvRegions.resize( m_MPISize );
   for ( int split = 0; split < m_MPISize; ++split )
     {
     recvRegions[ split ] = m_MPIOutputRegions[ m_MPIRank ];
@@ -297,7 +353,27 @@ MPIStreamingImageFilter< TImageType >
       s.Fill( 0 );
       recvRegions[ split ].SetSize( s );
       }
+    }
+
+  //  check if all send regions are the same and not empty, except the
+  //  rank's send region
+  const RegionType & bcastRegion = sendRegions[ (m_MPIRank+1)%m_MPISize ];
+  int useBcastLocal = ( bcastRegion.GetNumberOfPixels() != 0 );
+  for ( int split = 0; split < m_MPISize; ++split )
+    {
+    if ( split != m_MPIRank )
+      {
+      useBcastLocal &= ( sendRegions[split] == bcastRegion );
+      }
+    }
+
+  std::vector< int > useBcast( m_MPISize );
+  MPI_Allgather( &useBcastLocal, 1, MPI_INT, &(useBcast[0]), 1, MPI_INT, MPI_COMM_WORLD );
 
+  std::vector< typename ImageType::Pointer > & recvImages = exchange.RecvImages;
+  recvImages.resize( m_MPISize );
+  for ( int split = 0; split < m_MPISize; ++split )
+    {
     if ( recvRegions[ split ].GetNumberOfPixels() != 0 )
       {
       recvImages[ split ] = ImageType::New();
@@ -310,128 +386,394 @@ MPIStreamingImageFilter< TImageType >
       }
     }  // end for split
 
+  // The region broadcast by this rank is extracted first, as the
+  // broadcasts are posted with the receives.
+  std::vector< typename ImageType::Pointer > & sendImages = exchange.SendImages;
+  sendImages.clear();
+  sendImages.resize( m_MPISize );
+  if ( useBcast[m_MPIRank] )
+    {
+    sendImages[ (m_MPIRank+1)%m_MPISize ] = this->ExtractSendImage( input, bcastRegion );
+    }
 
-  // MPI Bcasts
+  // Post the receives before extracting, so the data can arrive while
+  // the send regions are extracted. Every rank takes part in the
+  // broadcast of each rank which sends the same region to all, in the
+  // same order.
+  exchange.Requests.clear();
+  exchange.RequestSplits.clear();
+  exchange.SendRequests.clear();
+  exchange.CompletedReceives.clear();
+  exchange.NumberOfReceives = 0;
+  exchange.NumberOfBytesSent = 0;
+  exchange.NumberOfBytesReceived = 0;
   for ( int split = 0; split < m_MPISize; ++split )
     {
-    if ( useBcast[m_MPIRank] )
+    if ( useBcast[split] && split == m_MPIRank )
       {
       if ( m_MPIRank == 0 )
         {
         itkDebugMacro( << "--Bcast--" );
+        itkDebugMacro( << bcastRegion );
+        }
+
+      exchange.SendRequests.push_back( MPI_REQUEST_NULL );
+      MPI_Ibcast( sendImages[ (split+1)%m_MPISize ]->GetBufferPointer(),
+                  bcastRegion.GetNumberOfPixels(),
+                  m_MPIDataType,
+                  split,
+                  MPI_COMM_WORLD,
+                  &exchange.SendRequests.back() );
+      exchange.NumberOfBytesSent += ( m_MPISize - 1 ) * bcastRegion.GetNumberOfPixels() * sizeof( PixelType );
+      }
+    else if ( useBcast[split] || recvRegions[ split ].GetNumberOfPixels() != 0 )
+      {
+      if ( m_MPIRank == 0 )
+        {
+        itkDebugMacro( << ( useBcast[split] ? "--Bcast--" : "--RECEIVING--" ) );
         itkDebugMacro( << recvRegions[ split ] );
         }
 
-      if ( split == m_MPIRank )
+      exchange.Requests.push_back( MPI_REQUEST_NULL );
+      exchange.RequestSplits.push_back( split );
+      if ( useBcast[split] )
         {
-        MPI_Bcast( sendImages[ (split+1)%m_MPISize ]->GetBufferPointer(),
-                   sendRegions[ (split+1)%m_MPISize ].GetNumberOfPixels(),
-                   m_MPIDataType,
-                   split,
-                   MPI_COMM_WORLD );
+        MPI_Ibcast( recvImages[ split ]->GetBufferPointer(),
+                    recvRegions[ split ].GetNumberOfPixels(),
+                    m_MPIDataType,
+                    split,
+                    MPI_COMM_WORLD,
+                    &exchange.Requests.back() );
         }
       else
         {
-        MPI_Bcast( recvImages[ split ]->GetBufferPointer(),
+        MPI_Irecv( recvImages[ split ]->GetBufferPointer(),
                    recvRegions[ split ].GetNumberOfPixels(),
                    m_MPIDataType,
                    split,
-                   MPI_COMM_WORLD );
+                   m_MPITAG,
+                   MPI_COMM_WORLD,
+                   &exchange.Requests.back() );
         }
+      ++exchange.NumberOfReceives;
+      exchange.NumberOfBytesReceived += recvRegions[ split ].GetNumberOfPixels() * sizeof( PixelType );
       }
     }
 
-  // MPI Send/Receive
-  std::vector<MPI_Request> requests(m_MPISize*2);
-  std::vector<MPI_Status> statuses(m_MPISize*2);
-  size_t numberOfRequests = 0;
-  for ( int split = 0; split < m_MPISize; ++split )
+  // The receive requests are complete, so the progress thread can
+  // drive them while the send regions are extracted.
+  this->StartProgressThread( exchange );
+
+  // extract the send regions, and send each as soon as it is extracted
+  for ( int split = 0; split < m_MPISize && !useBcast[m_MPIRank]; ++split )
     {
-    if ( !useBcast[split] )
+    if ( sendRegions[ split ].GetNumberOfPixels() != 0 )
       {
-      if ( m_MPIRank == 0 )
+
+      // check if we can reuse an extracted image
+      for ( int i = 0; i < split; ++i )
         {
-        itkDebugMacro( << "--SENDING--" );
-        itkDebugMacro( << sendRegions[ split ] );
-        itkDebugMacro( << "--RECEIVING--" );
-        itkDebugMacro( << recvRegions[ split ] );
+        if ( sendImages[i] && sendImages[i]->GetLargestPossibleRegion() == sendRegions[ split ] )
+          {
+          sendImages[split] = sendImages[i];
+          }
         }
 
-      if ( recvRegions[ split ].GetNumberOfPixels() != 0 )
+      // if we didn't reuse the image, then extract it
+      if ( !sendImages[split] )
         {
-        MPI_Irecv( recvImages[ split ]->GetBufferPointer(),
-                   recvRegions[ split ].GetNumberOfPixels(),
-                   m_MPIDataType,
-                   split,
-                   m_MPITAG,
-                   MPI_COMM_WORLD,
-                   &requests[numberOfRequests++] );
+        sendImages[split] = this->ExtractSendImage( input, sendRegions[ split ] );
         }
-      if ( sendRegions[ split ].GetNumberOfPixels() != 0 &&  !useBcast[m_MPIRank] )
+
+      if ( m_MPIRank == 0 )
         {
-        MPI_Isend( sendImages[ split ]->GetBufferPointer(),
-                   sendRegions[ split ].GetNumberOfPixels(),
-                   m_MPIDataType,
-                   split,
-                   m_MPITAG,
-                   MPI_COMM_WORLD,
-                   &requests[numberOfRequests++] );
+        itkDebugMacro( << "--SENDING--" );
+        itkDebugMacro( << sendRegions[ split ] );
         }
+
+      exchange.SendRequests.push_back( MPI_REQUEST_NULL );
+      MPI_Isend( sendImages[ split ]->GetBufferPointer(),
+                 sendRegions[ split ].GetNumberOfPixels(),
+                 m_MPIDataType,
+                 split,
+                 m_MPITAG,
+                 MPI_COMM_WORLD,
+                 &exchange.SendRequests.back() );
+      exchange.NumberOfBytesSent += sendRegions[ split ].GetNumberOfPixels() * sizeof( PixelType );
       }
+    } // end for split
 
-    } // end send/receive for split
-  MPI_Waitall( numberOfRequests, &requests[0], &statuses[0] );
+  // copy input region to the working
+  if ( m_MPIInputRegions[ m_MPIRank ].GetNumberOfPixels() != 0 )
+    {
+    this->PasteIntoWorking( exchange, input, m_MPIInputRegions[ m_MPIRank ] );
+    }
+}
 
-  typename ImageType::Pointer working = ImageType::New();
-  working->Graft( this->GetOutput() );
 
-  // copy input region to the working
-  typedef itk::PasteImageFilter< ImageType, ImageType > PasteType;
-  typename PasteType::Pointer inputPaste = PasteType::New();
-  inputPaste->SetDestinationImage( working );
-  inputPaste->SetDestinationIndex( m_MPIInputRegions[ m_MPIRank ].GetIndex() );
-  inputPaste->SetSourceImage( input );
-  inputPaste->SetSourceRegion( m_MPIInputRegions[ m_MPIRank ] );
-  inputPaste->InPlaceOn();
-  inputPaste->Update();
+/**
+ *
+ */
+template < class TImageType >
+typename MPIStreamingImageFilter< TImageType >::ImageType::Pointer
+MPIStreamingImageFilter< TImageType >
+::ExtractSendImage( const ImageType *input, const RegionType &region )
+{
+  typedef itk::ExtractImageFilter< ImageType, ImageType > ExtractorType;
+  typename ExtractorType::Pointer extractor = ExtractorType::New();
+  extractor->SetInput( input );
+  extractor->SetExtractionRegion( region );
+  extractor->SetDirectionCollapseToIdentity();
+  try
+    {
+    extractor->Update();
+    }
+  catch ( itk::ExceptionObject  & e )
+    {
+    std::cerr << "RANK " << m_MPIRank << std::endl;
+    std::cerr << "Excpetion caught while exracting send region!" << std::endl;
+    std::cerr << e << std::endl;
+    }
+
+  return extractor->GetOutput();
+}
 
-  working = inputPaste->GetOutput();
 
-  // paste recved regions into outptut
+/**
+ *
+ */
+template < class TImageType >
+bool
+MPIStreamingImageFilter< TImageType >
+::CanReplicateInPlace() const
+{
+  const RegionType & largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+
   for ( int split = 0; split < m_MPISize; ++split )
     {
-    if ( m_MPIRank == 0 )
+    if ( m_MPIOutputRegions[ split ] != largestRegion )
       {
-      itkDebugMacro( << "--PASTING--" );
-      itkDebugMacro( << recvRegions[ split ] );
-      itkDebugMacro( << working->GetLargestPossibleRegion() );
+      return false;
       }
-    if ( recvRegions[ split ].GetNumberOfPixels() != 0 )
+    }
+
+  // Each input region must be a contiguous range of the output
+  // buffer: the dimensions below the first partial dimension are
+  // complete, and the ones above it have a size of one.
+  for ( int split = 0; split < m_MPISize; ++split )
+    {
+    const RegionType & region = m_MPIInputRegions[ split ];
+    if ( region.GetNumberOfPixels() == 0 )
+      {
+      continue;
+      }
+
+    unsigned int j = 0;
+    while ( j < ImageType::ImageDimension && region.GetSize( j ) == largestRegion.GetSize( j ) )
+      {
+      ++j;
+      }
+    for ( ++j; j < ImageType::ImageDimension; ++j )
       {
-      // Paste the receive image into working
-      typename PasteType::Pointer paste = PasteType::New();
-      paste->SetDestinationImage( working );
-      paste->SetDestinationIndex( recvRegions[ split ].GetIndex() );
-      paste->SetSourceImage( recvImages[ split ] );
-      paste->SetSourceRegion( recvRegions[ split ] );
-      paste->InPlaceOn();
-      try
+      if ( region.GetSize( j ) != 1 )
         {
-        paste->Update();
+        return false;
         }
-      catch( itk::ExceptionObject & excep )
+      }
+    }
+
+  // the counts and displacements of MPI are ints
+  return largestRegion.GetNumberOfPixels() <= static_cast< SizeValueType >( NumericTraits< int >::max() );
+}
+
+
+/**
+ *
+ */
+template < class TImageType >
+void
+MPIStreamingImageFilter< TImageType >
+::StartReplicateExchange( ExchangeType &exchange )
+{
+  const ImageType * input = this->GetInput();
+  const RegionType & inputRegion = m_MPIInputRegions[ m_MPIRank ];
+
+  // place this rank's region directly in the output buffer
+  if ( inputRegion.GetNumberOfPixels() != 0 )
+    {
+    ImageAlgorithm::Copy( input, exchange.Working.GetPointer(), inputRegion, inputRegion );
+    }
+
+  exchange.Counts.resize( m_MPISize );
+  exchange.Displacements.resize( m_MPISize );
+  exchange.NumberOfBytesSent = ( m_MPISize - 1 ) * inputRegion.GetNumberOfPixels() * sizeof( PixelType );
+  exchange.NumberOfBytesReceived = 0;
+  for ( int split = 0; split < m_MPISize; ++split )
+    {
+    const RegionType & region = m_MPIInputRegions[ split ];
+    exchange.Counts[ split ] = static_cast< int >( region.GetNumberOfPixels() );
+    if ( split != m_MPIRank )
+      {
+      exchange.NumberOfBytesReceived += region.GetNumberOfPixels() * sizeof( PixelType );
+      }
+    exchange.Displacements[ split ] = 0;
+    if ( region.GetNumberOfPixels() != 0 )
+      {
+      exchange.Displacements[ split ] = static_cast< int >( exchange.Working->ComputeOffset( region.GetIndex() ) );
+      }
+    }
+
+  if ( m_MPIRank == 0 )
+    {
+    itkDebugMacro( << "--ALLGATHER--" );
+    }
+
+  exchange.Requests.assign( 1, MPI_REQUEST_NULL );
+  exchange.RequestSplits.assign( 1, -1 );
+  exchange.SendRequests.clear();
+  exchange.NumberOfReceives = 0;
+  MPI_Iallgatherv( MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                   exchange.Working->GetBufferPointer(),
+                   &exchange.Counts[0],
+                   &exchange.Displacements[0],
+                   m_MPIDataType,
+                   MPI_COMM_WORLD,
+                   &exchange.Requests[0] );
+
+  this->StartProgressThread( exchange );
+}
+
+
+/**
+ *
+ */
+template < class TImageType >
+void
+MPIStreamingImageFilter< TImageType >
+::StartProgressThread( ExchangeType &exchange )
+{
+  // Drive the non-blocking transfers from a separate thread, while
+  // this thread pastes the regions.
+  if ( m_UseCommunicationThread && !exchange.Requests.empty() )
+    {
+    int provided = MPI_THREAD_SINGLE;
+    MPI_Query_thread( &provided );
+    if ( provided == MPI_THREAD_MULTIPLE )
+      {
+      exchange.ProgressThread = std::thread( &Self::ProgressExchange, &exchange );
+      }
+    else
+      {
+      itkWarningMacro( "UseCommunicationThread requires MPI_THREAD_MULTIPLE, the communication will progress on the main thread." );
+      }
+    }
+}
+
+
+/**
+ *
+ */
+template < class TImageType >
+void
+MPIStreamingImageFilter< TImageType >
+::ProgressExchange( ExchangeType *exchange )
+{
+  int index;
+  MPI_Waitany( static_cast< int >( exchange->Requests.size() ), &exchange->Requests[0], &index, MPI_STATUS_IGNORE );
+  while ( index != MPI_UNDEFINED )
+    {
+    if ( exchange->RequestSplits[ index ] >= 0 )
+      {
+      std::lock_guard< std::mutex > lock( exchange->Mutex );
+      exchange->CompletedReceives.push_back( exchange->RequestSplits[ index ] );
+      exchange->ReceiveCompleted.notify_one();
+      }
+    MPI_Waitany( static_cast< int >( exchange->Requests.size() ), &exchange->Requests[0], &index, MPI_STATUS_IGNORE );
+    }
+}
+
+
+/**
+ *
+ */
+template < class TImageType >
+void
+MPIStreamingImageFilter< TImageType >
+::FinishExchange( ExchangeType &exchange )
+{
+  // paste recved regions into outptut as they are completed
+  for ( size_t numberOfPasted = 0; numberOfPasted < exchange.NumberOfReceives; ++numberOfPasted )
+    {
+    int split = -1;
+    if ( exchange.ProgressThread.joinable() )
+      {
+      std::unique_lock< std::mutex > lock( exchange.Mutex );
+      exchange.ReceiveCompleted.wait( lock, [&exchange] { return !exchange.CompletedReceives.empty(); } );
+      split = exchange.CompletedReceives.front();
+      exchange.CompletedReceives.pop_front();
+      }
+    else
+      {
+      while ( split < 0 )
         {
-        std::cerr << "Exception caught while updating receive paste!" << std::endl;
-        std::cerr << excep << std::endl;
+        int index;
+        MPI_Waitany( static_cast< int >( exchange.Requests.size() ), &exchange.Requests[0], &index, MPI_STATUS_IGNORE );
+        split = exchange.RequestSplits[ index ];
         }
-      working = paste->GetOutput();
+      }
 
-      } // end use neighbors
-    } // end use for split
+    if ( m_MPIRank == 0 )
+      {
+      itkDebugMacro( << "--PASTING--" );
+      itkDebugMacro( << exchange.RecvRegions[ split ] );
+      itkDebugMacro( << exchange.Working->GetLargestPossibleRegion() );
+      }
+
+    // Paste the receive image into working
+    this->PasteIntoWorking( exchange, exchange.RecvImages[ split ], exchange.RecvRegions[ split ] );
+    } // end for pasted
+
+  // wait for the remaining requests and the sends
+  if ( exchange.ProgressThread.joinable() )
+    {
+    exchange.ProgressThread.join();
+    }
+  else if ( !exchange.Requests.empty() )
+    {
+    MPI_Waitall( static_cast< int >( exchange.Requests.size() ), &exchange.Requests[0], MPI_STATUSES_IGNORE );
+    }
+  if ( !exchange.SendRequests.empty() )
+    {
+    MPI_Waitall( static_cast< int >( exchange.SendRequests.size() ), &exchange.SendRequests[0], MPI_STATUSES_IGNORE );
+    }
+}
 
-  working->SetLargestPossibleRegion( input->GetLargestPossibleRegion() );
-  this->GraftOutput( working );
 
+/**
+ *
+ */
+template < class TImageType >
+void
+MPIStreamingImageFilter< TImageType >
+::PasteIntoWorking( ExchangeType &exchange, const ImageType *source, const RegionType &region )
+{
+  typedef itk::PasteImageFilter< ImageType, ImageType > PasteType;
+  typename PasteType::Pointer paste = PasteType::New();
+  paste->SetDestinationImage( exchange.Working );
+  paste->SetDestinationIndex( region.GetIndex() );
+  paste->SetSourceImage( source );
+  paste->SetSourceRegion( region );
+  paste->InPlaceOn();
+  try
+    {
+    paste->Update();
+    }
+  catch( itk::ExceptionObject & excep )
+    {
+    std::cerr << "Exception caught while updating receive paste!" << std::endl;
+    std::cerr << excep << std::endl;
+    }
+  exchange.Working = paste->GetOutput();
 }
 
 /**
@@ -446,6 +788,9 @@ MPIStreamingImageFilter< TImageType >
   os << indent << "MPITAG: " << m_MPITAG << std::endl;
   os << indent << "MPIRank: " << m_MPIRank << std::endl;
   os << indent << "MPISize: " << m_MPISize << std::endl;
+  os << indent << "UseCommunicationThread: " << m_UseCommunicationThread << std::endl;
+  os << indent << "ReplicateOutput: " << m_ReplicateOutput << std::endl;
+  os << indent << "PendingExchange: " << ( m_PendingExchange ? "yes" : "no" ) << std::endl;
 
   const Indent indent2 = indent.GetNextIndent();
   os << indent << "MPIOutputRegions:" << std::endl;
@@ -0,0 +1,243 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMultiStatisticsImageSinc_h
+#define itkMultiStatisticsImageSinc_h
+
+#include "itkStreamingImageSinc.h"
+#include "itkSimpleDataObjectDecorator.h"
+#include "itkHistogram.h"
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+
+/** \class MultiStatisticsImageSinc
+ *
+ * \brief Compute several statistics of an image in a single streamed
+ * pass.
+ *
+ * The bounding region of the non-zero pixels, the minimum and
+ * maximum, the mean, variance and sum, and a histogram can each be
+ * enabled independently. All the enabled statistics are computed
+ * together on each streamed piece, so the upstream pipeline is only
+ * executed once instead of once per statistic.
+ *
+ * Each chunk is accumulated locally and then merged into the
+ * total. The mean and variance are merged with the pairwise update of
+ * Chan et al., which is numerically stable for large images. The sum
+ * is accumulated separately with Neumaier's compensated summation, so
+ * it stays exact on large integer images as long as it fits in the
+ * RealType.
+ *
+ * The outputs of the statistics which are not computed are reset on
+ * each update: the region is empty, the values are zero and the
+ * histogram has no bins.
+ *
+ * The histogram bounds must be known before streaming, the default is
+ * the range of the pixel type with 256 bins. Values outside of the
+ * bounds are not counted.
+ *
+ * \ingroup StreamingSinc
+ **/
+template< class TInputImage >
+class MultiStatisticsImageSinc
+  : public StreamingImageSinc<TInputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef MultiStatisticsImageSinc          Self;
+  typedef StreamingImageSinc< TInputImage > Superclass;
+  typedef SmartPointer< Self >              Pointer;
+  typedef SmartPointer< const Self >        ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MultiStatisticsImageSinc, StreamingImageSinc);
+
+  /** Image type information. */
+  typedef typename Superclass::InputImageType       InputImageType;
+  typedef typename Superclass::InputImageRegionType RegionType;
+  typedef typename InputImageType::PixelType        PixelType;
+  typedef typename NumericTraits< PixelType >::RealType RealType;
+
+  typedef SimpleDataObjectDecorator< RegionType > RegionObjectType;
+  typedef SimpleDataObjectDecorator< PixelType >  PixelObjectType;
+  typedef SimpleDataObjectDecorator< RealType >   RealObjectType;
+  typedef Statistics::Histogram< RealType >       HistogramType;
+
+  // Change the acces from protected to public
+  using Superclass::SetNumberOfStreamDivisions;
+  using Superclass::GetNumberOfStreamDivisions;
+
+  /** Select which statistics are computed. */
+  itkSetMacro(ComputeBoundingRegion, bool);
+  itkGetConstMacro(ComputeBoundingRegion, bool);
+  itkBooleanMacro(ComputeBoundingRegion);
+
+  itkSetMacro(ComputeMinimumMaximum, bool);
+  itkGetConstMacro(ComputeMinimumMaximum, bool);
+  itkBooleanMacro(ComputeMinimumMaximum);
+
+  itkSetMacro(ComputeMeanVariance, bool);
+  itkGetConstMacro(ComputeMeanVariance, bool);
+  itkBooleanMacro(ComputeMeanVariance);
+
+  itkSetMacro(ComputeHistogram, bool);
+  itkGetConstMacro(ComputeHistogram, bool);
+  itkBooleanMacro(ComputeHistogram);
+
+  /** Histogram parameters. */
+  itkSetClampMacro(NumberOfBins, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfBins, unsigned int);
+  itkSetMacro(HistogramLowerBound, RealType);
+  itkGetConstMacro(HistogramLowerBound, RealType);
+  itkSetMacro(HistogramUpperBound, RealType);
+  itkGetConstMacro(HistogramUpperBound, RealType);
+
+  /** Bounding region of the non-zero pixels. */
+  RegionObjectType *GetRegionOutput()
+    { return static_cast< RegionObjectType * >( this->ProcessObject::GetOutput(0) ); }
+  const RegionObjectType *GetRegionOutput() const
+    { return static_cast< const RegionObjectType * >( this->ProcessObject::GetOutput(0) ); }
+  RegionType GetRegion(void) const
+    { return this->GetRegionOutput()->Get(); }
+
+  PixelObjectType *GetMinimumOutput()
+    { return static_cast< PixelObjectType * >( this->ProcessObject::GetOutput(1) ); }
+  const PixelObjectType *GetMinimumOutput() const
+    { return static_cast< const PixelObjectType * >( this->ProcessObject::GetOutput(1) ); }
+  PixelType GetMinimum(void) const
+    { return this->GetMinimumOutput()->Get(); }
+
+  PixelObjectType *GetMaximumOutput()
+    { return static_cast< PixelObjectType * >( this->ProcessObject::GetOutput(2) ); }
+  const PixelObjectType *GetMaximumOutput() const
+    { return static_cast< const PixelObjectType * >( this->ProcessObject::GetOutput(2) ); }
+  PixelType GetMaximum(void) const
+    { return this->GetMaximumOutput()->Get(); }
+
+  RealObjectType *GetMeanOutput()
+    { return static_cast< RealObjectType * >( this->ProcessObject::GetOutput(3) ); }
+  const RealObjectType *GetMeanOutput() const
+    { return static_cast< const RealObjectType * >( this->ProcessObject::GetOutput(3) ); }
+  RealType GetMean(void) const
+    { return this->GetMeanOutput()->Get(); }
+
+  RealObjectType *GetVarianceOutput()
+    { return static_cast< RealObjectType * >( this->ProcessObject::GetOutput(4) ); }
+  const RealObjectType *GetVarianceOutput() const
+    { return static_cast< const RealObjectType * >( this->ProcessObject::GetOutput(4) ); }
+  RealType GetVariance(void) const
+    { return this->GetVarianceOutput()->Get(); }
+
+  RealObjectType *GetSigmaOutput()
+    { return static_cast< RealObjectType * >( this->ProcessObject::GetOutput(5) ); }
+  const RealObjectType *GetSigmaOutput() const
+    { return static_cast< const RealObjectType * >( this->ProcessObject::GetOutput(5) ); }
+  RealType GetSigma(void) const
+    { return this->GetSigmaOutput()->Get(); }
+
+  RealObjectType *GetSumOutput()
+    { return static_cast< RealObjectType * >( this->ProcessObject::GetOutput(6) ); }
+  const RealObjectType *GetSumOutput() const
+    { return static_cast< const RealObjectType * >( this->ProcessObject::GetOutput(6) ); }
+  RealType GetSum(void) const
+    { return this->GetSumOutput()->Get(); }
+
+  HistogramType *GetHistogramOutput()
+    { return static_cast< HistogramType * >( this->ProcessObject::GetOutput(7) ); }
+  const HistogramType *GetHistogramOutput() const
+    { return static_cast< const HistogramType * >( this->ProcessObject::GetOutput(7) ); }
+  const HistogramType *GetHistogram(void) const
+    { return this->GetHistogramOutput(); }
+
+  /** Number of pixels which contributed to the mean and variance. */
+  SizeValueType GetCount(void) const
+    { return m_Accumulator.Count; }
+
+  using Superclass::MakeOutput;
+  DataObject::Pointer MakeOutput(typename Superclass::DataObjectPointerArraySizeType  output) override;
+
+protected:
+  MultiStatisticsImageSinc();
+  ~MultiStatisticsImageSinc() {}
+
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  void BeforeStreamedGenerateData( void ) override;
+
+  void ThreadedStreamedGenerateData(const RegionType &inputRegionForChunk) override;
+
+  void AfterStreamedGenerateData( void ) override;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(MultiStatisticsImageSinc);
+
+  /** Partial statistics of a chunk, or of all the chunks merged so
+   * far. */
+  struct AccumulatorType
+  {
+    RegionType                  Region;
+    PixelType                   Minimum;
+    PixelType                   Maximum;
+    SizeValueType               Count;
+    RealType                    Mean;
+    RealType                    M2;
+    RealType                    Sum;
+    RealType                    SumCompensation;
+    std::vector<SizeValueType>  Histogram;
+  };
+
+  void InitializeAccumulator( AccumulatorType &acc ) const;
+
+  /** Merge b into a. */
+  static void MergeAccumulator( AccumulatorType &a, const AccumulatorType &b );
+
+  /** Pairwise merge of the count, mean and sum of squared differences
+   * from the mean. */
+  static void MergeMoments( SizeValueType &countA, RealType &meanA, RealType &m2A,
+                            SizeValueType countB, RealType meanB, RealType m2B );
+
+  /** Add a value to a sum with Neumaier's compensated summation. */
+  static void CompensatedAdd( RealType &sum, RealType &compensation, RealType value );
+
+  bool m_ComputeBoundingRegion;
+  bool m_ComputeMinimumMaximum;
+  bool m_ComputeMeanVariance;
+  bool m_ComputeHistogram;
+
+  unsigned int m_NumberOfBins;
+  RealType     m_HistogramLowerBound;
+  RealType     m_HistogramUpperBound;
+
+  AccumulatorType m_Accumulator;
+
+  std::mutex m_Mutex;
+};
+
+} // end namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMultiStatisticsImageSinc.hxx"
+#endif
+
+#endif //itkMultiStatisticsImageSinc_h
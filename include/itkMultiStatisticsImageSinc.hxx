@@ -0,0 +1,414 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkMultiStatisticsImageSinc_hxx
+#define itkMultiStatisticsImageSinc_hxx
+
+#include "itkMultiStatisticsImageSinc.h"
+#include "itkBoundingRegionImageSinc.h"
+#include "itkImageScanlineIterator.h"
+#include <cmath>
+
+namespace itk
+{
+
+/**
+ *
+ */
+template < class TInputImage >
+MultiStatisticsImageSinc< TInputImage >
+::MultiStatisticsImageSinc()
+  : m_ComputeBoundingRegion( true ),
+    m_ComputeMinimumMaximum( true ),
+    m_ComputeMeanVariance( true ),
+    m_ComputeHistogram( true ),
+    m_NumberOfBins( 256 ),
+    m_HistogramLowerBound( static_cast< RealType >( NumericTraits< PixelType >::NonpositiveMin() ) ),
+    m_HistogramUpperBound( static_cast< RealType >( NumericTraits< PixelType >::max() ) )
+{
+  this->ProcessObject::SetNumberOfRequiredOutputs(8);
+  for ( unsigned int i = 0; i < 8; ++i )
+    {
+    this->ProcessObject::SetNthOutput( i, this->MakeOutput(i).GetPointer() );
+    }
+
+  this->InitializeAccumulator( m_Accumulator );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+DataObject::Pointer
+MultiStatisticsImageSinc< TInputImage >
+::MakeOutput(typename Superclass::DataObjectPointerArraySizeType  output)
+{
+  switch ( output )
+    {
+    case 0:
+      return RegionObjectType::New().GetPointer();
+    case 1:
+    case 2:
+      return PixelObjectType::New().GetPointer();
+    case 3:
+    case 4:
+    case 5:
+    case 6:
+      return RealObjectType::New().GetPointer();
+    case 7:
+      return HistogramType::New().GetPointer();
+    default:
+      return nullptr;
+    }
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+MultiStatisticsImageSinc< TInputImage >
+::InitializeAccumulator( AccumulatorType &acc ) const
+{
+  acc.Region = RegionType();
+  acc.Minimum = NumericTraits< PixelType >::max();
+  acc.Maximum = NumericTraits< PixelType >::NonpositiveMin();
+  acc.Count = 0;
+  acc.Mean = NumericTraits< RealType >::ZeroValue();
+  acc.M2 = NumericTraits< RealType >::ZeroValue();
+  acc.Sum = NumericTraits< RealType >::ZeroValue();
+  acc.SumCompensation = NumericTraits< RealType >::ZeroValue();
+  acc.Histogram.assign( m_ComputeHistogram ? m_NumberOfBins : 0, 0 );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+MultiStatisticsImageSinc< TInputImage >
+::MergeMoments( SizeValueType &countA, RealType &meanA, RealType &m2A,
+                SizeValueType countB, RealType meanB, RealType m2B )
+{
+  if ( countB == 0 )
+    {
+    return;
+    }
+
+  const SizeValueType count = countA + countB;
+  const RealType delta = meanB - meanA;
+
+  meanA += delta * static_cast< RealType >( countB ) / count;
+  m2A += m2B + delta * delta * ( static_cast< RealType >( countA ) * countB / count );
+  countA = count;
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+MultiStatisticsImageSinc< TInputImage >
+::CompensatedAdd( RealType &sum, RealType &compensation, RealType value )
+{
+  const RealType t = sum + value;
+  if ( std::abs( sum ) >= std::abs( value ) )
+    {
+    compensation += ( sum - t ) + value;
+    }
+  else
+    {
+    compensation += ( value - t ) + sum;
+    }
+  sum = t;
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+MultiStatisticsImageSinc< TInputImage >
+::MergeAccumulator( AccumulatorType &a, const AccumulatorType &b )
+{
+  a.Region = BoundingRegionImageSinc< TInputImage >::RegionUnion( a.Region, b.Region );
+
+  a.Minimum = std::min( a.Minimum, b.Minimum );
+  a.Maximum = std::max( a.Maximum, b.Maximum );
+
+  MergeMoments( a.Count, a.Mean, a.M2, b.Count, b.Mean, b.M2 );
+  CompensatedAdd( a.Sum, a.SumCompensation, b.Sum );
+  a.SumCompensation += b.SumCompensation;
+
+  for ( size_t i = 0; i < b.Histogram.size(); ++i )
+    {
+    a.Histogram[i] += b.Histogram[i];
+    }
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+MultiStatisticsImageSinc< TInputImage >
+::BeforeStreamedGenerateData( void )
+{
+  if ( m_ComputeHistogram && !( m_HistogramLowerBound < m_HistogramUpperBound ) )
+    {
+    itkExceptionMacro( "HistogramLowerBound must be less than HistogramUpperBound" );
+    }
+
+  this->InitializeAccumulator( m_Accumulator );
+
+  Superclass::BeforeStreamedGenerateData();
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+MultiStatisticsImageSinc< TInputImage >
+::ThreadedStreamedGenerateData( const RegionType &inputRegionForChunk )
+{
+  typedef ImageScanlineConstIterator< TInputImage > InputConstIteratorType;
+
+  const InputImageType *inputPtr = this->GetInput();
+
+  AccumulatorType acc;
+  this->InitializeAccumulator( acc );
+
+  typename InputImageType::IndexType lower, upper;
+  for ( unsigned int i = 0; i < InputImageType::ImageDimension; ++i )
+    {
+    lower[i] = NumericTraits< IndexValueType >::max();
+    upper[i] = NumericTraits< IndexValueType >::NonpositiveMin();
+    }
+
+  // the values of a line are kept so that the sum of squared
+  // differences is computed about the mean of the line
+  std::vector< RealType > line;
+  if ( m_ComputeMeanVariance )
+    {
+    line.resize( inputRegionForChunk.GetSize(0) );
+    }
+
+  const RealType histogramLower = m_HistogramLowerBound;
+  const RealType histogramUpper = m_HistogramUpperBound;
+  const RealType binScale = m_NumberOfBins / ( histogramUpper - histogramLower );
+
+  InputConstIteratorType inputIt( inputPtr, inputRegionForChunk );
+
+  inputIt.GoToBegin();
+  while ( !inputIt.IsAtEnd() )
+    {
+    const typename InputImageType::IndexType lineIndex = inputIt.GetIndex();
+
+    IndexValueType first = NumericTraits< IndexValueType >::max();
+    IndexValueType last = NumericTraits< IndexValueType >::NonpositiveMin();
+    RealType lineSum = NumericTraits< RealType >::ZeroValue();
+    SizeValueType n = 0;
+
+    while ( !inputIt.IsAtEndOfLine() )
+      {
+      const PixelType v = inputIt.Get();
+
+      if ( m_ComputeBoundingRegion && v != NumericTraits< PixelType >::ZeroValue() )
+        {
+        const IndexValueType x = lineIndex[0] + static_cast< IndexValueType >( n );
+        first = std::min( first, x );
+        last = x;
+        }
+
+      if ( m_ComputeMinimumMaximum )
+        {
+        acc.Minimum = std::min( acc.Minimum, v );
+        acc.Maximum = std::max( acc.Maximum, v );
+        }
+
+      if ( m_ComputeMeanVariance )
+        {
+        line[n] = static_cast< RealType >( v );
+        lineSum += line[n];
+        }
+
+      if ( m_ComputeHistogram )
+        {
+        const RealType rv = static_cast< RealType >( v );
+        if ( rv >= histogramLower && rv <= histogramUpper )
+          {
+          SizeValueType bin = static_cast< SizeValueType >( ( rv - histogramLower ) * binScale );
+          if ( bin >= m_NumberOfBins )
+            {
+            bin = m_NumberOfBins - 1;
+            }
+          ++acc.Histogram[bin];
+          }
+        }
+
+      ++n;
+      ++inputIt;
+      }
+
+    if ( first <= last )
+      {
+      lower[0] = std::min( lower[0], first );
+      upper[0] = std::max( upper[0], last );
+      for ( unsigned int i = 1; i < InputImageType::ImageDimension; ++i )
+        {
+        lower[i] = std::min( lower[i], lineIndex[i] );
+        upper[i] = std::max( upper[i], lineIndex[i] );
+        }
+      }
+
+    if ( m_ComputeMeanVariance && n != 0 )
+      {
+      const RealType lineMean = lineSum / n;
+      RealType lineM2 = NumericTraits< RealType >::ZeroValue();
+      for ( SizeValueType i = 0; i < n; ++i )
+        {
+        const RealType d = line[i] - lineMean;
+        lineM2 += d * d;
+        }
+      MergeMoments( acc.Count, acc.Mean, acc.M2, n, lineMean, lineM2 );
+      CompensatedAdd( acc.Sum, acc.SumCompensation, lineSum );
+      }
+
+    inputIt.NextLine();
+    }
+
+  acc.Region.SetIndex( lower );
+  for ( unsigned int i = 0; i < InputImageType::ImageDimension; ++i )
+    {
+    if ( lower[i] <= upper[i] )
+      {
+      acc.Region.SetSize( i, upper[i] - lower[i] + 1 );
+      }
+    else
+      {
+      acc.Region.SetSize( i, 0 );
+      }
+    }
+
+  std::lock_guard<std::mutex> mutexHolder( m_Mutex );
+  MergeAccumulator( m_Accumulator, acc );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+MultiStatisticsImageSinc< TInputImage >
+::AfterStreamedGenerateData( void )
+{
+  Superclass::AfterStreamedGenerateData();
+
+  // the outputs of the statistics which are not computed are reset
+  this->GetRegionOutput()->Set( m_ComputeBoundingRegion ? m_Accumulator.Region : RegionType() );
+
+  if ( m_ComputeMinimumMaximum )
+    {
+    this->GetMinimumOutput()->Set( m_Accumulator.Minimum );
+    this->GetMaximumOutput()->Set( m_Accumulator.Maximum );
+    }
+  else
+    {
+    this->GetMinimumOutput()->Set( NumericTraits< PixelType >::ZeroValue() );
+    this->GetMaximumOutput()->Set( NumericTraits< PixelType >::ZeroValue() );
+    }
+
+  if ( m_ComputeMeanVariance )
+    {
+    const SizeValueType count = m_Accumulator.Count;
+    RealType variance = NumericTraits< RealType >::ZeroValue();
+    if ( count > 1 )
+      {
+      variance = m_Accumulator.M2 / ( count - 1 );
+      }
+
+    this->GetMeanOutput()->Set( m_Accumulator.Mean );
+    this->GetVarianceOutput()->Set( variance );
+    this->GetSigmaOutput()->Set( std::sqrt( variance ) );
+    this->GetSumOutput()->Set( m_Accumulator.Sum + m_Accumulator.SumCompensation );
+    }
+  else
+    {
+    this->GetMeanOutput()->Set( NumericTraits< RealType >::ZeroValue() );
+    this->GetVarianceOutput()->Set( NumericTraits< RealType >::ZeroValue() );
+    this->GetSigmaOutput()->Set( NumericTraits< RealType >::ZeroValue() );
+    this->GetSumOutput()->Set( NumericTraits< RealType >::ZeroValue() );
+    }
+
+  HistogramType *histogram = this->GetHistogramOutput();
+  histogram->SetMeasurementVectorSize( 1 );
+  if ( m_ComputeHistogram )
+    {
+    typename HistogramType::SizeType size( 1 );
+    size.Fill( m_NumberOfBins );
+
+    typename HistogramType::MeasurementVectorType lowerBound( 1 );
+    typename HistogramType::MeasurementVectorType upperBound( 1 );
+    lowerBound.Fill( m_HistogramLowerBound );
+    upperBound.Fill( m_HistogramUpperBound );
+
+    histogram->Initialize( size, lowerBound, upperBound );
+    for ( unsigned int i = 0; i < m_NumberOfBins; ++i )
+      {
+      histogram->SetFrequency( i, m_Accumulator.Histogram[i] );
+      }
+    }
+  else
+    {
+    typename HistogramType::SizeType size( 1 );
+    size.Fill( 0 );
+    histogram->Initialize( size );
+    }
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+MultiStatisticsImageSinc< TInputImage >
+::PrintSelf( std::ostream & os, Indent indent ) const
+{
+  Superclass::PrintSelf( os, indent );
+  os << indent << "ComputeBoundingRegion: " << m_ComputeBoundingRegion << std::endl;
+  os << indent << "ComputeMinimumMaximum: " << m_ComputeMinimumMaximum << std::endl;
+  os << indent << "ComputeMeanVariance: " << m_ComputeMeanVariance << std::endl;
+  os << indent << "ComputeHistogram: " << m_ComputeHistogram << std::endl;
+  os << indent << "NumberOfBins: " << m_NumberOfBins << std::endl;
+  os << indent << "HistogramLowerBound: " << m_HistogramLowerBound << std::endl;
+  os << indent << "HistogramUpperBound: " << m_HistogramUpperBound << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,284 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStreamingImageSinc_h
+#define itkStreamingImageSinc_h
+
+#include "itkImageSink.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+
+/** \class StreamingImageSinc
+ *
+ * \brief Base class for the streaming sinks in this module.
+ *
+ * By default each streamed piece is split statically across the work
+ * units, as done by ImageSink. When NumberOfChunksPerWorkUnit is
+ * greater than one, each piece is over-decomposed into that many
+ * chunks per work unit and the chunks are handed out through a shared
+ * counter, so work units which finish early pick up more chunks. This
+ * helps when the cost of processing is not uniform over the image,
+ * such as with sparse masks. The chunks are split over all the
+ * dimensions of the piece, and only cover the piece even when the
+ * upstream filters enlarge the requested region of the input.
+ *
+ * Sub-classes implement ThreadedStreamedGenerateData as with
+ * ImageSink, it is called once per chunk.
+ *
+ * Long executions can be checkpointed by setting a
+ * CheckpointFileName. The number of completed pieces and the partial
+ * state of the sink are written to that file every
+ * CheckpointPieceInterval pieces or CheckpointTimeInterval seconds,
+ * and when the execution is aborted. The next update with the same
+ * configuration resumes after the last saved piece, and the file is
+ * removed when all the pieces are completed. Sub-classes support this
+ * by implementing SaveStreamedState and RestoreStreamedState.
+ *
+ * With ReuseStreamBuffers enabled, the upstream filters keep their
+ * output buffers between pieces instead of releasing and allocating
+ * them for each piece, as a piece of the same or smaller size fits in
+ * the previous buffer. Upstream outputs of the input image type which
+ * are not yet allocated, and have the same largest possible region as
+ * the input, are reserved for the largest piece, with the pages first
+ * touched by the work units and optionally advised to use huge
+ * pages. The upstream ReleaseDataBeforeUpdateFlags are restored
+ * after the update.
+ *
+ * The pieces are processed in the order given by PieceOrder. The
+ * natural order is the order of the region splitter. The tile order
+ * groups the pieces by the tile of PieceOrderTileSize which contains
+ * their first index, with the tiles in the order of the image buffer,
+ * so that the pieces follow the tile or chunk layout of a file. The
+ * Morton and Hilbert orders sort the pieces along a space-filling curve
+ * through their first index, which keeps consecutive pieces close when
+ * the splitter divides several dimensions. Sub-classes may provide
+ * other orders by overriding GeneratePieceOrder. The order does not
+ * change the results of the sinks.
+ *
+ * \ingroup StreamingSinc
+ **/
+template< class TInputImage >
+class StreamingImageSinc
+  : public ImageSink<TInputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef StreamingImageSinc          Self;
+  typedef ImageSink< TInputImage >    Superclass;
+  typedef SmartPointer< Self >        Pointer;
+  typedef SmartPointer< const Self >  ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(StreamingImageSinc, ImageSink);
+
+  /** Image type information. */
+  typedef typename Superclass::InputImageType       InputImageType;
+  typedef typename Superclass::InputImageRegionType InputImageRegionType;
+  typedef typename InputImageType::SizeType         SizeType;
+
+  // Change the acces from protected to public
+  using Superclass::SetRegionSplitter;
+  using Superclass::GetRegionSplitter;
+
+  /** The orders in which the streamed pieces can be processed. */
+  typedef enum
+    {
+    NaturalPieceOrder = 0,
+    TilePieceOrder,
+    MortonPieceOrder,
+    HilbertPieceOrder
+    } PieceOrderType;
+
+  /** Set/Get the number of chunks each work unit should process per
+   * streamed piece. A value of 1 uses the static decomposition of
+   * ImageSink, larger values enable dynamic scheduling of the
+   * chunks. */
+  itkSetClampMacro(NumberOfChunksPerWorkUnit, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfChunksPerWorkUnit, unsigned int);
+
+  /** Set/Get the file used to checkpoint the streamed execution. An
+   * empty file name, the default, disables checkpointing. */
+  itkSetStringMacro(CheckpointFileName);
+  itkGetStringMacro(CheckpointFileName);
+
+  /** Set/Get the number of pieces between checkpoints, zero disables
+   * checkpointing by the number of pieces. The default is 1. */
+  itkSetMacro(CheckpointPieceInterval, unsigned int);
+  itkGetConstMacro(CheckpointPieceInterval, unsigned int);
+
+  /** Set/Get the time in seconds between checkpoints, zero, the
+   * default, disables checkpointing by time. A checkpoint is only
+   * written after a piece is completed. */
+  itkSetClampMacro(CheckpointTimeInterval, double, 0.0, NumericTraits<double>::max());
+  itkGetConstMacro(CheckpointTimeInterval, double);
+
+  /** Set/Get if the buffers of the upstream filters are reused across
+   * the streamed pieces. The default is off. */
+  itkSetMacro(ReuseStreamBuffers, bool);
+  itkGetConstMacro(ReuseStreamBuffers, bool);
+  itkBooleanMacro(ReuseStreamBuffers);
+
+  /** Set/Get if the buffers reserved for reuse are advised to use
+   * transparent huge pages. Only supported on Linux. The default is
+   * off. */
+  itkSetMacro(UseHugePages, bool);
+  itkGetConstMacro(UseHugePages, bool);
+  itkBooleanMacro(UseHugePages);
+
+  /** Set/Get the order in which the streamed pieces are
+   * processed. The default is NaturalPieceOrder. */
+  itkSetMacro(PieceOrder, PieceOrderType);
+  itkGetConstMacro(PieceOrder, PieceOrderType);
+
+  /** Set/Get the size of the tiles used by TilePieceOrder. A size of
+   * zero in a dimension covers the whole image in that dimension,
+   * which is the default. */
+  itkSetMacro(PieceOrderTileSize, SizeType);
+  itkGetConstReferenceMacro(PieceOrderTileSize, SizeType);
+
+  /** Restores the state of the upstream pipeline changed for reusing
+   * buffers. */
+  void UpdateOutputData(DataObject *output) override;
+
+protected:
+  StreamingImageSinc();
+  ~StreamingImageSinc() {}
+
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  void BeforeStreamedGenerateData( void ) override;
+
+  /** When resuming from a checkpoint only the remaining pieces are
+   * reported, and the piece numbers are offset to the remaining
+   * pieces. */
+  unsigned int GetNumberOfInputRequestedRegions( void ) override;
+
+  void GenerateNthInputRequestedRegion(unsigned int inputRequestedRegionNumber) override;
+
+  void StreamedGenerateData(unsigned int inputRequestedRegionNumber) override;
+
+  /** Process a piece as chunks dynamically assigned to the work units. */
+  void ChunkedStreamedGenerateData(unsigned int inputRequestedRegionNumber);
+
+  /** Write the partial results accumulated over the pieces completed
+   * so far. Returns false if the sink does not support checkpointing,
+   * which is the default. */
+  virtual bool SaveStreamedState( std::ostream & itkNotUsed(os) ) const
+    { return false; }
+
+  /** Restore the partial results written by SaveStreamedState. This
+   * is called from BeforeStreamedGenerateData after the sink has been
+   * initialized. Returns false on failure. */
+  virtual bool RestoreStreamedState( std::istream & itkNotUsed(is) )
+    { return false; }
+
+  /** Generate the order in which the pieces are processed, as a
+   * permutation of the piece numbers. This is called from
+   * BeforeStreamedGenerateData, when the number of pieces is known. */
+  virtual void GeneratePieceOrder( std::vector< unsigned int > & order );
+
+  /** The number of pieces of the current execution. */
+  unsigned int GetNumberOfPieces( void ) const
+    { return m_NumberOfPieces; }
+
+  /** The position of a point with the given coordinates along a Morton
+   * or Hilbert curve. Each of the dimension coordinates must fit in
+   * numberOfBits, and numberOfBits times the dimension must not exceed
+   * 64. The coordinates are modified. */
+  static std::uint64_t SpaceFillingCurveKey( std::uint64_t *x,
+                                             unsigned int dimension,
+                                             unsigned int numberOfBits,
+                                             bool hilbert );
+
+  /** A description of the configuration of the execution. A
+   * checkpoint is only resumed if this is unchanged. */
+  virtual std::string GetCheckpointSignature( void ) const;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(StreamingImageSinc);
+
+  static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION ChunkThreaderCallback( void *arg );
+
+  struct ChunkThreadStruct
+  {
+    Self                      *Filter;
+    InputImageRegionType       Region;
+    unsigned int               NumberOfChunks;
+    std::atomic<unsigned int>  NextChunk;
+  };
+
+  void ReadCheckpoint( void );
+  void WriteCheckpoint( unsigned int numberOfCompletedPieces );
+
+  /** Disable the release of the upstream buffers and reserve the
+   * unallocated ones. */
+  void PrepareStreamBuffers( void );
+  void PrepareStreamBuffers( ProcessObject *source, SizeValueType numberOfPixels );
+  void ReserveStreamBuffer( InputImageType *image, SizeValueType numberOfPixels );
+  void RestoreStreamBuffers( void );
+
+  unsigned int m_NumberOfChunksPerWorkUnit;
+
+  std::string  m_CheckpointFileName;
+  unsigned int m_CheckpointPieceInterval;
+  double       m_CheckpointTimeInterval;
+
+  // state of the current execution
+  bool         m_CheckpointActive;
+  bool         m_GeneratingNthInputRequestedRegion;
+  unsigned int m_NumberOfPieces;
+  unsigned int m_FirstPiece;
+  unsigned int m_LastCheckpointPiece;
+  std::chrono::steady_clock::time_point m_LastCheckpointTime;
+
+  bool m_ReuseStreamBuffers;
+  bool m_UseHugePages;
+
+  PieceOrderType               m_PieceOrder;
+  SizeType                     m_PieceOrderTileSize;
+  std::vector< unsigned int >  m_PieceOrderPermutation;
+
+  // the region of the piece being processed
+  InputImageRegionType         m_CurrentPieceRegion;
+
+  // the class of the region splitter of the current execution, as the
+  // splitter is only accessible from a non-const sink
+  std::string                  m_RegionSplitterName;
+
+  typedef std::pair< ProcessObject::Pointer, bool > ReleaseDataBeforeUpdateFlagType;
+  std::vector< ReleaseDataBeforeUpdateFlagType > m_ReleaseDataBeforeUpdateFlags;
+
+  ImageRegionSplitterBase::Pointer m_ChunkSplitter;
+};
+
+} // end namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkStreamingImageSinc.hxx"
+#endif
+
+#endif //itkStreamingImageSinc_h
@@ -0,0 +1,717 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkStreamingImageSinc_hxx
+#define itkStreamingImageSinc_hxx
+
+#include "itkStreamingImageSinc.h"
+#include "itksys/SystemTools.hxx"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace itk
+{
+
+/**
+ *
+ */
+template < class TInputImage >
+StreamingImageSinc< TInputImage >
+::StreamingImageSinc()
+  : m_NumberOfChunksPerWorkUnit( 1 ),
+    m_CheckpointPieceInterval( 1 ),
+    m_CheckpointTimeInterval( 0.0 ),
+    m_CheckpointActive( false ),
+    m_GeneratingNthInputRequestedRegion( false ),
+    m_NumberOfPieces( 0 ),
+    m_FirstPiece( 0 ),
+    m_LastCheckpointPiece( 0 ),
+    m_ReuseStreamBuffers( false ),
+    m_UseHugePages( false ),
+    m_PieceOrder( NaturalPieceOrder )
+{
+  m_PieceOrderTileSize.Fill( 0 );
+  // splits all the dimensions, so thin pieces still give many chunks
+  m_ChunkSplitter = ImageRegionSplitterMultidimensional::New();
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::BeforeStreamedGenerateData( void )
+{
+  Superclass::BeforeStreamedGenerateData();
+
+  m_FirstPiece = 0;
+  m_NumberOfPieces = Superclass::GetNumberOfInputRequestedRegions();
+  m_RegionSplitterName = this->GetRegionSplitter()->GetNameOfClass();
+
+  m_PieceOrderPermutation.clear();
+  this->GeneratePieceOrder( m_PieceOrderPermutation );
+
+  std::vector< bool > ordered( m_NumberOfPieces, false );
+  bool isPermutation = ( m_PieceOrderPermutation.size() == m_NumberOfPieces );
+  for ( size_t i = 0; isPermutation && i < m_PieceOrderPermutation.size(); ++i )
+    {
+    const unsigned int piece = m_PieceOrderPermutation[i];
+    isPermutation = ( piece < m_NumberOfPieces && !ordered[piece] );
+    if ( isPermutation )
+      {
+      ordered[piece] = true;
+      }
+    }
+  if ( !isPermutation )
+    {
+    itkExceptionMacro( "The piece order is not a permutation of the " << m_NumberOfPieces << " pieces" );
+    }
+
+  m_CheckpointActive = false;
+  if ( !m_CheckpointFileName.empty() )
+    {
+    std::ostringstream probe;
+    m_CheckpointActive = this->SaveStreamedState( probe );
+    if ( !m_CheckpointActive )
+      {
+      itkWarningMacro( "Checkpointing is not supported by " << this->GetNameOfClass() );
+      }
+    }
+
+  if ( m_CheckpointActive )
+    {
+    this->ReadCheckpoint();
+    }
+
+  m_LastCheckpointPiece = m_FirstPiece;
+  m_LastCheckpointTime = std::chrono::steady_clock::now();
+
+  if ( m_ReuseStreamBuffers )
+    {
+    this->PrepareStreamBuffers();
+    }
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::UpdateOutputData( DataObject *output )
+{
+  try
+    {
+    Superclass::UpdateOutputData( output );
+    }
+  catch ( ... )
+    {
+    this->RestoreStreamBuffers();
+    throw;
+    }
+  this->RestoreStreamBuffers();
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+unsigned int
+StreamingImageSinc< TInputImage >
+::GetNumberOfInputRequestedRegions( void )
+{
+  const unsigned int numberOfPieces = Superclass::GetNumberOfInputRequestedRegions();
+
+  // The superclass splits the input with the total number of pieces.
+  if ( m_GeneratingNthInputRequestedRegion )
+    {
+    return numberOfPieces;
+    }
+  return numberOfPieces - std::min( m_FirstPiece, numberOfPieces );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::GenerateNthInputRequestedRegion( unsigned int inputRequestedRegionNumber )
+{
+  m_GeneratingNthInputRequestedRegion = true;
+  try
+    {
+    const unsigned int position = inputRequestedRegionNumber + m_FirstPiece;
+    const unsigned int piece = ( position < m_PieceOrderPermutation.size() )
+      ? m_PieceOrderPermutation[position]
+      : position;
+    Superclass::GenerateNthInputRequestedRegion( piece );
+
+    // The requested region of the input may have been enlarged by the
+    // upstream filters, the piece is what must be processed.
+    m_CurrentPieceRegion = this->GetInput()->GetLargestPossibleRegion();
+    this->GetRegionSplitter()->GetSplit( piece, m_NumberOfPieces, m_CurrentPieceRegion );
+    }
+  catch ( ... )
+    {
+    m_GeneratingNthInputRequestedRegion = false;
+    throw;
+    }
+  m_GeneratingNthInputRequestedRegion = false;
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::StreamedGenerateData( unsigned int inputRequestedRegionNumber )
+{
+  if ( m_NumberOfChunksPerWorkUnit <= 1 )
+    {
+    Superclass::StreamedGenerateData( inputRequestedRegionNumber );
+    }
+  else
+    {
+    this->ChunkedStreamedGenerateData( inputRequestedRegionNumber );
+    }
+
+  if ( !m_CheckpointActive )
+    {
+    return;
+    }
+
+  const unsigned int numberOfCompletedPieces = inputRequestedRegionNumber + m_FirstPiece + 1;
+
+  if ( numberOfCompletedPieces == m_NumberOfPieces )
+    {
+    itksys::SystemTools::RemoveFile( m_CheckpointFileName );
+    return;
+    }
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_LastCheckpointTime;
+
+  if ( this->GetAbortGenerateData()
+       || ( m_CheckpointPieceInterval != 0
+            && numberOfCompletedPieces - m_LastCheckpointPiece >= m_CheckpointPieceInterval )
+       || ( m_CheckpointTimeInterval > 0.0 && elapsed.count() >= m_CheckpointTimeInterval ) )
+    {
+    this->WriteCheckpoint( numberOfCompletedPieces );
+    }
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::ChunkedStreamedGenerateData( unsigned int inputRequestedRegionNumber )
+{
+  const ThreadIdType numberOfWorkUnits = this->GetNumberOfWorkUnits();
+
+  ChunkThreadStruct str;
+  str.Filter = this;
+  str.Region = m_CurrentPieceRegion;
+
+  const SizeValueType numberOfChunks = std::min< SizeValueType >(
+    static_cast< SizeValueType >( numberOfWorkUnits ) * m_NumberOfChunksPerWorkUnit,
+    NumericTraits< unsigned int >::max() );
+  str.NumberOfChunks = m_ChunkSplitter->GetNumberOfSplits( str.Region, static_cast< unsigned int >( numberOfChunks ) );
+  str.NextChunk = 0;
+
+  itkDebugMacro( "Processing piece " << inputRequestedRegionNumber << " as "
+                 << str.NumberOfChunks << " chunks" );
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits( numberOfWorkUnits );
+  this->GetMultiThreader()->SetSingleMethod( Self::ChunkThreaderCallback, &str );
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  this->UpdateProgress( float( inputRequestedRegionNumber + 1 ) / this->GetNumberOfInputRequestedRegions() );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
+StreamingImageSinc< TInputImage >
+::ChunkThreaderCallback( void *arg )
+{
+  typedef MultiThreaderBase::WorkUnitInfo WorkUnitInfoType;
+
+  ChunkThreadStruct *str = static_cast< ChunkThreadStruct * >( static_cast< WorkUnitInfoType * >( arg )->UserData );
+
+  // each work unit takes the next available chunk until there are
+  // none left
+  unsigned int chunk;
+  while ( ( chunk = str->NextChunk++ ) < str->NumberOfChunks )
+    {
+    InputImageRegionType chunkRegion = str->Region;
+    str->Filter->m_ChunkSplitter->GetSplit( chunk, str->NumberOfChunks, chunkRegion );
+
+    str->Filter->ThreadedStreamedGenerateData( chunkRegion );
+    }
+
+  return ITK_THREAD_RETURN_DEFAULT_VALUE;
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::GeneratePieceOrder( std::vector< unsigned int > & order )
+{
+  const unsigned int numberOfPieces = m_NumberOfPieces;
+
+  order.resize( numberOfPieces );
+  for ( unsigned int piece = 0; piece < numberOfPieces; ++piece )
+    {
+    order[piece] = piece;
+    }
+
+  if ( m_PieceOrder == NaturalPieceOrder || numberOfPieces < 2 )
+    {
+    return;
+    }
+
+  const unsigned int dimension = InputImageType::ImageDimension;
+  const InputImageRegionType & largestRegion = this->GetInput()->GetLargestPossibleRegion();
+
+  // the first index of each piece, relative to the largest region
+  std::vector< std::uint64_t > offsets( numberOfPieces * dimension );
+  std::uint64_t maximumOffset = 0;
+  for ( unsigned int piece = 0; piece < numberOfPieces; ++piece )
+    {
+    InputImageRegionType region = largestRegion;
+    this->GetRegionSplitter()->GetSplit( piece, numberOfPieces, region );
+    for ( unsigned int i = 0; i < dimension; ++i )
+      {
+      const std::uint64_t offset = static_cast< std::uint64_t >( region.GetIndex(i) - largestRegion.GetIndex(i) );
+      offsets[piece * dimension + i] = offset;
+      maximumOffset = std::max( maximumOffset, offset );
+      }
+    }
+
+  std::vector< std::uint64_t > keys( numberOfPieces, 0 );
+  if ( m_PieceOrder == TilePieceOrder )
+    {
+    for ( unsigned int piece = 0; piece < numberOfPieces; ++piece )
+      {
+      // the tiles are numbered with the first dimension fastest
+      std::uint64_t key = 0;
+      std::uint64_t stride = 1;
+      for ( unsigned int i = 0; i < dimension; ++i )
+        {
+        if ( m_PieceOrderTileSize[i] != 0 )
+          {
+          key += stride * ( offsets[piece * dimension + i] / m_PieceOrderTileSize[i] );
+          stride *= ( largestRegion.GetSize(i) + m_PieceOrderTileSize[i] - 1 ) / m_PieceOrderTileSize[i];
+          }
+        }
+      keys[piece] = key;
+      }
+    }
+  else
+    {
+    unsigned int numberOfBits = 1;
+    while ( numberOfBits < 64 && ( maximumOffset >> numberOfBits ) != 0 )
+      {
+      ++numberOfBits;
+      }
+
+    // drop the low bits when the key would not fit in 64 bits, the
+    // order of the pieces which then share a key is kept
+    const unsigned int maximumNumberOfBits = 64 / dimension;
+    const unsigned int shift = ( numberOfBits > maximumNumberOfBits ) ? numberOfBits - maximumNumberOfBits : 0;
+
+    std::vector< std::uint64_t > x( dimension );
+    for ( unsigned int piece = 0; piece < numberOfPieces; ++piece )
+      {
+      for ( unsigned int i = 0; i < dimension; ++i )
+        {
+        x[i] = offsets[piece * dimension + i] >> shift;
+        }
+      keys[piece] = SpaceFillingCurveKey( &x[0], dimension, numberOfBits - shift,
+                                          m_PieceOrder == HilbertPieceOrder );
+      }
+    }
+
+  std::stable_sort( order.begin(), order.end(),
+                    [&keys]( unsigned int a, unsigned int b ) { return keys[a] < keys[b]; } );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+std::uint64_t
+StreamingImageSinc< TInputImage >
+::SpaceFillingCurveKey( std::uint64_t *x, unsigned int dimension, unsigned int numberOfBits, bool hilbert )
+{
+  if ( hilbert && numberOfBits > 0 )
+    {
+    // Transform the coordinates to the transposed Hilbert index, from
+    // J. Skilling, "Programming the Hilbert curve", AIP Conference
+    // Proceedings 707, 2004.
+    const std::uint64_t m = std::uint64_t(1) << ( numberOfBits - 1 );
+    for ( std::uint64_t q = m; q > 1; q >>= 1 )
+      {
+      const std::uint64_t p = q - 1;
+      for ( unsigned int i = 0; i < dimension; ++i )
+        {
+        if ( x[i] & q )
+          {
+          x[0] ^= p;
+          }
+        else
+          {
+          const std::uint64_t t = ( x[0] ^ x[i] ) & p;
+          x[0] ^= t;
+          x[i] ^= t;
+          }
+        }
+      }
+
+    // Gray encode
+    for ( unsigned int i = 1; i < dimension; ++i )
+      {
+      x[i] ^= x[i-1];
+      }
+    std::uint64_t t = 0;
+    for ( std::uint64_t q = m; q > 1; q >>= 1 )
+      {
+      if ( x[dimension-1] & q )
+        {
+        t ^= q - 1;
+        }
+      }
+    for ( unsigned int i = 0; i < dimension; ++i )
+      {
+      x[i] ^= t;
+      }
+    }
+
+  // interleave the bits, from the most significant, with the first
+  // dimension first
+  std::uint64_t key = 0;
+  for ( unsigned int b = numberOfBits; b > 0; --b )
+    {
+    for ( unsigned int i = 0; i < dimension; ++i )
+      {
+      key = ( key << 1 ) | ( ( x[i] >> ( b - 1 ) ) & 1 );
+      }
+    }
+  return key;
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+std::string
+StreamingImageSinc< TInputImage >
+::GetCheckpointSignature( void ) const
+{
+  const InputImageRegionType & region = this->GetInput()->GetLargestPossibleRegion();
+
+  std::ostringstream signature;
+  signature << this->GetNameOfClass() << " " << InputImageType::ImageDimension;
+  for ( unsigned int i = 0; i < InputImageType::ImageDimension; ++i )
+    {
+    signature << " " << region.GetIndex(i) << " " << region.GetSize(i);
+    }
+  signature << " " << m_NumberOfPieces;
+  signature << " " << m_RegionSplitterName;
+
+  // a resumed execution must process the pieces in the same order
+  std::uint64_t orderHash = 14695981039346656037ULL;
+  for ( size_t i = 0; i < m_PieceOrderPermutation.size(); ++i )
+    {
+    orderHash = ( orderHash ^ m_PieceOrderPermutation[i] ) * 1099511628211ULL;
+    }
+  signature << " " << orderHash;
+  return signature.str();
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::ReadCheckpoint( void )
+{
+  std::ifstream checkpoint( m_CheckpointFileName.c_str() );
+  if ( !checkpoint )
+    {
+    return;
+    }
+
+  std::string signature;
+  unsigned int numberOfCompletedPieces = 0;
+
+  std::getline( checkpoint, signature );
+  checkpoint >> numberOfCompletedPieces;
+  checkpoint.ignore( 1 );
+
+  if ( !checkpoint || signature != this->GetCheckpointSignature() )
+    {
+    itkWarningMacro( "Ignoring checkpoint \"" << m_CheckpointFileName << "\" from a different configuration" );
+    return;
+    }
+
+  if ( numberOfCompletedPieces >= m_NumberOfPieces || !this->RestoreStreamedState( checkpoint ) )
+    {
+    itkExceptionMacro( "Unable to restore checkpoint \"" << m_CheckpointFileName << "\"" );
+    }
+
+  itkDebugMacro( "Resuming after piece " << numberOfCompletedPieces << " of " << m_NumberOfPieces );
+  m_FirstPiece = numberOfCompletedPieces;
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::WriteCheckpoint( unsigned int numberOfCompletedPieces )
+{
+  // Write a new file then replace the previous checkpoint, so a valid
+  // checkpoint exists if the process is killed while writing.
+  const std::string temporaryFileName = m_CheckpointFileName + ".tmp";
+  {
+  std::ofstream checkpoint( temporaryFileName.c_str(), std::ios::out | std::ios::trunc );
+  checkpoint << this->GetCheckpointSignature() << "\n";
+  checkpoint << numberOfCompletedPieces << "\n";
+  if ( !this->SaveStreamedState( checkpoint ) || !checkpoint.flush() )
+    {
+    itkExceptionMacro( "Unable to write checkpoint \"" << temporaryFileName << "\"" );
+    }
+  }
+
+  if ( !itksys::SystemTools::RenameFile( temporaryFileName, m_CheckpointFileName ) )
+    {
+    itkExceptionMacro( "Unable to rename checkpoint to \"" << m_CheckpointFileName << "\"" );
+    }
+
+  m_LastCheckpointPiece = numberOfCompletedPieces;
+  m_LastCheckpointTime = std::chrono::steady_clock::now();
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::PrepareStreamBuffers( void )
+{
+  // the size of the largest piece
+  const InputImageRegionType & largestRegion = this->GetInput()->GetLargestPossibleRegion();
+  SizeValueType numberOfPixels = 0;
+  for ( unsigned int piece = 0; piece < m_NumberOfPieces; ++piece )
+    {
+    InputImageRegionType region = largestRegion;
+    this->GetRegionSplitter()->GetSplit( piece, m_NumberOfPieces, region );
+    numberOfPixels = std::max( numberOfPixels, region.GetNumberOfPixels() );
+    }
+
+  for ( unsigned int idx = 0; idx < this->GetNumberOfIndexedInputs(); ++idx )
+    {
+    DataObject *input = this->ProcessObject::GetInput( idx );
+    if ( input )
+      {
+      this->PrepareStreamBuffers( input->GetSource(), numberOfPixels );
+      }
+    }
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::PrepareStreamBuffers( ProcessObject *source, SizeValueType numberOfPixels )
+{
+  if ( !source )
+    {
+    return;
+    }
+
+  // already visited
+  for ( size_t i = 0; i < m_ReleaseDataBeforeUpdateFlags.size(); ++i )
+    {
+    if ( m_ReleaseDataBeforeUpdateFlags[i].first.GetPointer() == source )
+      {
+      return;
+      }
+    }
+
+  m_ReleaseDataBeforeUpdateFlags.push_back( ReleaseDataBeforeUpdateFlagType( source, source->GetReleaseDataBeforeUpdateFlag() ) );
+  source->SetReleaseDataBeforeUpdateFlag( false );
+
+  // Only the outputs on the grid of the input follow its pieces, the
+  // others are left to grow their buffers as usual.
+  const InputImageRegionType & largestRegion = this->GetInput()->GetLargestPossibleRegion();
+  ProcessObject::DataObjectPointerArray outputs = source->GetOutputs();
+  for ( size_t i = 0; i < outputs.size(); ++i )
+    {
+    InputImageType *image = dynamic_cast< InputImageType * >( outputs[i].GetPointer() );
+    if ( image && image->GetLargestPossibleRegion() == largestRegion )
+      {
+      this->ReserveStreamBuffer( image, numberOfPixels );
+      }
+    }
+
+  ProcessObject::DataObjectPointerArray inputs = source->GetInputs();
+  for ( size_t i = 0; i < inputs.size(); ++i )
+    {
+    if ( inputs[i] )
+      {
+      this->PrepareStreamBuffers( inputs[i]->GetSource(), numberOfPixels );
+      }
+    }
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::ReserveStreamBuffer( InputImageType *image, SizeValueType numberOfPixels )
+{
+  typedef typename InputImageType::InternalPixelType InternalPixelType;
+
+  // Only unallocated buffers are reserved, an allocated buffer may
+  // hold data which is already up to date. Images with a pixel
+  // container of a different size than the number of pixels, such as
+  // VectorImage, are not reserved.
+  if ( image->GetBufferPointer() != nullptr || numberOfPixels == 0
+       || !std::is_same< InternalPixelType, typename InputImageType::PixelType >::value )
+    {
+    return;
+    }
+
+  const SizeValueType numberOfElements = numberOfPixels;
+
+  // allocated as the container does, so it may take ownership
+  InternalPixelType *buffer = new InternalPixelType[numberOfElements];
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if ( m_UseHugePages )
+    {
+    const size_t pageSize = static_cast< size_t >( sysconf( _SC_PAGESIZE ) );
+    const size_t begin = ( reinterpret_cast< size_t >( buffer ) + pageSize - 1 ) & ~( pageSize - 1 );
+    const size_t end = ( reinterpret_cast< size_t >( buffer + numberOfElements ) ) & ~( pageSize - 1 );
+    if ( end > begin )
+      {
+      madvise( reinterpret_cast< void * >( begin ), end - begin, MADV_HUGEPAGE );
+      }
+    }
+#endif
+
+  // First touch the pages by the work units in large blocks, so the
+  // pages are local to the threads which will later use them.
+  const SizeValueType numberOfBlocks = std::max< SizeValueType >( this->GetNumberOfWorkUnits(), 1 );
+  const SizeValueType blockSize = ( numberOfElements + numberOfBlocks - 1 ) / numberOfBlocks;
+  this->GetMultiThreader()->SetNumberOfWorkUnits( this->GetNumberOfWorkUnits() );
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfBlocks,
+    [buffer, blockSize, numberOfElements]( SizeValueType block )
+      {
+      const SizeValueType first = std::min( block * blockSize, numberOfElements );
+      const SizeValueType last = std::min( first + blockSize, numberOfElements );
+      std::fill( buffer + first, buffer + last, InternalPixelType() );
+      },
+    nullptr );
+
+  itkDebugMacro( "Reserved " << numberOfPixels << " pixels for " << image );
+
+  image->GetPixelContainer()->SetImportPointer( buffer, numberOfElements, true );
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::RestoreStreamBuffers( void )
+{
+  for ( size_t i = 0; i < m_ReleaseDataBeforeUpdateFlags.size(); ++i )
+    {
+    m_ReleaseDataBeforeUpdateFlags[i].first->SetReleaseDataBeforeUpdateFlag( m_ReleaseDataBeforeUpdateFlags[i].second );
+    }
+  m_ReleaseDataBeforeUpdateFlags.clear();
+}
+
+
+/**
+ *
+ */
+template < class TInputImage >
+void
+StreamingImageSinc< TInputImage >
+::PrintSelf( std::ostream & os, Indent indent ) const
+{
+  Superclass::PrintSelf( os, indent );
+  os << indent << "NumberOfChunksPerWorkUnit: " << m_NumberOfChunksPerWorkUnit << std::endl;
+  os << indent << "CheckpointFileName: " << m_CheckpointFileName << std::endl;
+  os << indent << "CheckpointPieceInterval: " << m_CheckpointPieceInterval << std::endl;
+  os << indent << "CheckpointTimeInterval: " << m_CheckpointTimeInterval << std::endl;
+  os << indent << "ReuseStreamBuffers: " << m_ReuseStreamBuffers << std::endl;
+  os << indent << "UseHugePages: " << m_UseHugePages << std::endl;
+  os << indent << "PieceOrder: " << static_cast< int >( m_PieceOrder ) << std::endl;
+  os << indent << "PieceOrderTileSize: " << m_PieceOrderTileSize << std::endl;
+}
+
+} // end namespace itk
+
+#endif
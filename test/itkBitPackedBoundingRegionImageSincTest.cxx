@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "itkImage.h"
+#include "itkBinaryImageToBitPackedImageFilter.h"
+#include "itkBitPackedBoundingRegionImageSinc.h"
+#include "itkImageFileReader.h"
+#include "itkTestingMacros.h"
+#include <cmath>
+
+int itkBitPackedBoundingRegionImageSincTest(int argc, char* argv[] )
+{
+
+  if( argc < 3 )
+    {
+    std::cerr << "Missing Arguments" << std::endl;
+    std::cerr << "Usage: " << std::endl;
+    std::cerr << argv[0] << " inputImage numberOfStreamDivisions" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  unsigned int numberOfStreamDivisions = std::max( atoi( argv[2] ), 1 );
+
+  typedef itk::Image<unsigned char,2> ImageType;
+
+  typedef itk::ImageFileReader< ImageType >    ReaderType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+
+  reader->SetFileName( argv[1] );
+
+  typedef itk::BinaryImageToBitPackedImageFilter<ImageType> PackerType;
+  PackerType::Pointer packer = PackerType::New();
+
+  EXERCISE_BASIC_OBJECT_METHODS( packer, BinaryImageToBitPackedImageFilter, ImageToImageFilter );
+
+  packer->SetInput( reader->GetOutput() );
+
+  typedef itk::BitPackedBoundingRegionImageSinc<PackerType::OutputImageType> RegionFilterType;
+  RegionFilterType::Pointer filter = RegionFilterType::New();
+
+  EXERCISE_BASIC_OBJECT_METHODS( filter, BitPackedBoundingRegionImageSinc, BoundingRegionImageSinc );
+
+  filter->SetInput(packer->GetOutput());
+  filter->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  // the packed image covers the input with whole words
+  const ImageType::RegionType inputRegion = reader->GetOutput()->GetLargestPossibleRegion();
+  const PackerType::OutputImageType::RegionType packedRegion = packer->GetOutput()->GetLargestPossibleRegion();
+  TEST_EXPECT_EQUAL( packedRegion.GetSize(0), ( inputRegion.GetSize(0) + 63 ) / 64 );
+  TEST_EXPECT_EQUAL( packedRegion.GetSize(1), inputRegion.GetSize(1) );
+
+  // the center of a word is at the center of the pixels it holds
+  PackerType::OutputImageType::IndexType wordIndex = packedRegion.GetIndex();
+  wordIndex[0] += 1;
+  PackerType::OutputImageType::PointType wordCenter;
+  packer->GetOutput()->TransformIndexToPhysicalPoint( wordIndex, wordCenter );
+  itk::ContinuousIndex< double, 2 > inputIndex;
+  reader->GetOutput()->TransformPhysicalPointToContinuousIndex( wordCenter, inputIndex );
+  TEST_EXPECT_TRUE( std::abs( inputIndex[0] - ( 64.0 * wordIndex[0] + 31.5 ) ) < 1e-6 );
+  TEST_EXPECT_TRUE( std::abs( inputIndex[1] - wordIndex[1] ) < 1e-6 );
+
+  std::cout << "Region: " << filter->GetRegion().GetIndex()
+            << " " << filter->GetRegion().GetSize() << std::endl;
+
+  return EXIT_SUCCESS;
+}
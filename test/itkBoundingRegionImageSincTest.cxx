@@ -20,6 +20,9 @@
 #include "itkImage.h"
 #include "itkBoundingRegionImageSinc.h"
 #include "itkImageFileReader.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include "itkCastImageFilter.h"
+#include <set>
 #include "itkTestingMacros.h"
 
 int itkBoundingRegionImageSincTest(int argc, char* argv[] )
@@ -29,11 +32,26 @@ int itkBoundingRegionImageSincTest(int argc, char* argv[] )
     {
     std::cerr << "Missing Arguments" << std::endl;
     std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " inputImage numberOfStreamDivisions" << std::endl;
+    std::cerr << argv[0] << " inputImage numberOfStreamDivisions [numberOfChunksPerWorkUnit] [reuseStreamBuffers] [pieceOrder]" << std::endl;
     return EXIT_FAILURE;
   }
 
   unsigned int numberOfStreamDivisions = std::max( atoi( argv[2] ), 1 );
+  unsigned int numberOfChunksPerWorkUnit = 1;
+  if ( argc > 3 )
+    {
+    numberOfChunksPerWorkUnit = std::max( atoi( argv[3] ), 1 );
+    }
+  bool reuseStreamBuffers = false;
+  if ( argc > 4 )
+    {
+    reuseStreamBuffers = ( atoi( argv[4] ) != 0 );
+    }
+  int pieceOrder = 0;
+  if ( argc > 5 )
+    {
+    pieceOrder = atoi( argv[5] );
+    }
 
   typedef itk::Image<unsigned char,2> ImageType;
 
@@ -46,10 +64,49 @@ int itkBoundingRegionImageSincTest(int argc, char* argv[] )
   typedef itk::BoundingRegionImageSinc<ImageType> RegionFilterType;
   RegionFilterType::Pointer filter = RegionFilterType::New();
 
-  EXERCISE_BASIC_OBJECT_METHODS( filter, BoundingRegionImageSinc, ImageSink );
+  EXERCISE_BASIC_OBJECT_METHODS( filter, BoundingRegionImageSinc, StreamingImageSinc );
+
+  // With reused buffers, a filter which allocates its output for each
+  // piece is placed before the sink, and the buffers of each piece are
+  // recorded.
+  typedef itk::CastImageFilter< ImageType, ImageType > CastFilterType;
+  CastFilterType::Pointer cast = CastFilterType::New();
+  cast->SetInput( reader->GetOutput() );
+  cast->InPlaceOff();
+  const bool releaseDataBeforeUpdate = cast->GetReleaseDataBeforeUpdateFlag();
 
-  filter->SetInput(reader->GetOutput());
+  std::set< const ImageType::PixelType * > buffers;
+  unsigned int numberOfCastUpdates = 0;
+  CastFilterType *rawCast = cast.GetPointer();
+  cast->AddObserver( itk::EndEvent(), [rawCast, &buffers, &numberOfCastUpdates]( const itk::EventObject & )
+    {
+      buffers.insert( rawCast->GetOutput()->GetBufferPointer() );
+      ++numberOfCastUpdates;
+    } );
+
+  if ( reuseStreamBuffers )
+    {
+    filter->SetInput( cast->GetOutput() );
+    }
+  else
+    {
+    filter->SetInput( reader->GetOutput() );
+    }
   filter->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  filter->SetNumberOfChunksPerWorkUnit( numberOfChunksPerWorkUnit );
+  filter->SetReuseStreamBuffers( reuseStreamBuffers );
+  filter->SetUseHugePages( reuseStreamBuffers );
+
+  if ( pieceOrder != 0 )
+    {
+    // divide all the dimensions, so the order of the pieces differs
+    filter->SetRegionSplitter( itk::ImageRegionSplitterMultidimensional::New() );
+
+    RegionFilterType::SizeType tileSize;
+    tileSize.Fill( 32 );
+    filter->SetPieceOrderTileSize( tileSize );
+    filter->SetPieceOrder( static_cast< RegionFilterType::PieceOrderType >( pieceOrder ) );
+    }
 
     try
     {
@@ -62,6 +119,15 @@ int itkBoundingRegionImageSincTest(int argc, char* argv[] )
     return EXIT_FAILURE;
     }
 
+  if ( reuseStreamBuffers )
+    {
+    // every piece used the same buffer, and the flag is restored
+    std::cout << "Cast updates: " << numberOfCastUpdates << " buffers: " << buffers.size() << std::endl;
+    TEST_EXPECT_TRUE( numberOfCastUpdates > 1 );
+    TEST_EXPECT_EQUAL( buffers.size(), 1u );
+    TEST_EXPECT_EQUAL( cast->GetReleaseDataBeforeUpdateFlag(), releaseDataBeforeUpdate );
+    }
+
     std::cout << "Region: " << filter->GetRegion().GetIndex()
               << " " << filter->GetRegion().GetSize() << std::endl;
 
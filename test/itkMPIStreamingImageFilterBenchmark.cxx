@@ -0,0 +1,286 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Scaling benchmark of the MPIStreamingImageFilter with a synthetic
+// source, so no file is read.
+//
+// Usage:
+//   mpirun -np N itkMPIStreamingImageFilterBenchmark [--size n]
+//     [--scaling strong|weak] [--pattern full,halo,replicate]
+//     [--halo h] [--repeat r]
+//
+// The image is n^3 pixels for strong scaling, and n^2 x (n N) pixels
+// for weak scaling, so each rank generates a slab of the same size.
+// The patterns redistribute the slabs generated by each rank:
+//  - full: rank 0 gathers the whole image, the other ranks keep their
+//    slab;
+//  - halo: each rank receives its slab extended by h slices on each
+//    side;
+//  - replicate: every rank receives the whole image.
+//
+// For each pattern rank 0 writes one JSON line with the maximum over
+// the ranks of the time of each phase, the total number of bytes
+// received, and the effective bandwidth of the exchange. A sweep is
+// done by running the benchmark for several numbers of ranks, e.g.:
+//   for n in 1 2 4 8; do mpirun -np $n itkMPIStreamingImageFilterBenchmark --scaling weak; done
+
+#include "itkMPIStreamingImageFilter.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkSyntheticMaskImageSource.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+typedef itk::Image< float, 3 >                          ImageType;
+typedef itk::SyntheticMaskImageSource< ImageType >       SourceType;
+typedef itk::MPIStreamingImageFilter< ImageType >        MPIStreamerType;
+
+enum
+{
+  GeneratePhase = 0,
+  StartPhase,
+  FinishPhase,
+  TotalPhase,
+  NumberOfPhases
+};
+
+const char * PhaseNames[NumberOfPhases] = { "generate", "start", "finish", "total" };
+
+
+std::vector< std::string > SplitList( const std::string & list )
+{
+  std::vector< std::string > items;
+  std::istringstream ss( list );
+  std::string item;
+  while ( std::getline( ss, item, ',' ) )
+    {
+    if ( !item.empty() )
+      {
+      items.push_back( item );
+      }
+    }
+  return items;
+}
+
+
+// The region this rank requests for a pattern.
+ImageType::RegionType RequestedRegion( const std::string & pattern,
+                                       const ImageType::RegionType & largestRegion,
+                                       int rank, int size, unsigned int halo )
+{
+  if ( pattern == "replicate" || ( pattern == "full" && rank == 0 ) )
+    {
+    return largestRegion;
+    }
+
+  // the same slab as generated by this rank
+  itk::ImageRegionSplitterSlowDimension::Pointer splitter = itk::ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfSplits = splitter->GetNumberOfSplits( largestRegion, size );
+  ImageType::RegionType region = largestRegion;
+  if ( static_cast< unsigned int >( rank ) < numberOfSplits )
+    {
+    splitter->GetSplit( rank, numberOfSplits, region );
+    }
+  else
+    {
+    // a single slice, as an empty region would be expanded to the
+    // largest region
+    region.SetSize( ImageType::ImageDimension - 1, 1 );
+    }
+
+  if ( pattern == "halo" )
+    {
+    ImageType::SizeType radius;
+    radius.Fill( 0 );
+    radius[ImageType::ImageDimension - 1] = halo;
+    region.PadByRadius( radius );
+    region.Crop( largestRegion );
+    }
+  return region;
+}
+
+} // end namespace
+
+
+int main( int argc, char *argv[] )
+{
+  MPI_Init( &argc, &argv );
+
+  int rank;
+  int size;
+  MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+  MPI_Comm_size( MPI_COMM_WORLD, &size );
+
+  unsigned int imageSize = 256;
+  bool weakScaling = false;
+  std::vector< std::string > patterns = SplitList( "full,halo,replicate" );
+  unsigned int halo = 2;
+  unsigned int repeat = 3;
+
+  for ( int i = 1; i + 1 < argc; i += 2 )
+    {
+    const std::string option = argv[i];
+    const std::string value = argv[i+1];
+    if ( option == "--size" )
+      {
+      imageSize = std::max( atoi( value.c_str() ), 1 );
+      }
+    else if ( option == "--scaling" )
+      {
+      weakScaling = ( value == "weak" );
+      }
+    else if ( option == "--pattern" )
+      {
+      patterns = SplitList( value );
+      }
+    else if ( option == "--halo" )
+      {
+      halo = std::max( atoi( value.c_str() ), 0 );
+      }
+    else if ( option == "--repeat" )
+      {
+      repeat = std::max( atoi( value.c_str() ), 1 );
+      }
+    else
+      {
+      if ( rank == 0 )
+        {
+        std::cerr << "Unknown option: " << option << std::endl;
+        }
+      MPI_Finalize();
+      return EXIT_FAILURE;
+      }
+    }
+
+  ImageType::SizeType sourceSize;
+  sourceSize.Fill( imageSize );
+  if ( weakScaling )
+    {
+    sourceSize[ImageType::ImageDimension - 1] *= size;
+    }
+
+  ImageType::RegionType largestRegion;
+  largestRegion.SetSize( sourceSize );
+
+  int status = EXIT_SUCCESS;
+  for ( size_t p = 0; p < patterns.size() && status == EXIT_SUCCESS; ++p )
+    {
+    const std::string & pattern = patterns[p];
+    if ( pattern != "full" && pattern != "halo" && pattern != "replicate" )
+      {
+      if ( rank == 0 )
+        {
+        std::cerr << "Unknown pattern: " << pattern << std::endl;
+        }
+      status = EXIT_FAILURE;
+      break;
+      }
+
+    SourceType::Pointer source = SourceType::New();
+    source->SetSize( sourceSize );
+    source->SetPattern( SourceType::RandomPattern );
+
+    // time the generation of the input
+    double generateStart = 0.0;
+    double generateTime = 0.0;
+    source->AddObserver( itk::StartEvent(), [&generateStart]( const itk::EventObject & )
+                         { generateStart = MPI_Wtime(); } );
+    source->AddObserver( itk::EndEvent(), [&generateStart, &generateTime]( const itk::EventObject & )
+                         { generateTime += MPI_Wtime() - generateStart; } );
+
+    MPIStreamerType::Pointer streamer = MPIStreamerType::New();
+    streamer->SetInput( source->GetOutput() );
+    streamer->SetReplicateOutput( pattern == "replicate" );
+
+    double best[NumberOfPhases] = { 0.0 };
+    double bestBytes = 0.0;
+    best[TotalPhase] = itk::NumericTraits< double >::max();
+
+    for ( unsigned int r = 0; r < repeat; ++r )
+      {
+      source->Modified();
+      streamer->GetOutput()->SetRequestedRegion( RequestedRegion( pattern, largestRegion, rank, size, halo ) );
+      generateTime = 0.0;
+
+      double local[NumberOfPhases];
+      double bytes = 0.0;
+      try
+        {
+        MPI_Barrier( MPI_COMM_WORLD );
+        const double t0 = MPI_Wtime();
+        MPIStreamerType::UpdateHandleType handle = streamer->StartUpdate();
+        const double t1 = MPI_Wtime();
+        ImageType::Pointer output = streamer->FinishUpdate( handle );
+        const double t2 = MPI_Wtime();
+
+        local[GeneratePhase] = generateTime;
+        local[StartPhase] = ( t1 - t0 ) - generateTime;
+        local[FinishPhase] = t2 - t1;
+        local[TotalPhase] = t2 - t0;
+        bytes = static_cast< double >( handle->GetNumberOfBytesReceived() );
+        }
+      catch ( itk::ExceptionObject & excp )
+        {
+        std::cerr << "RANK " << rank << ": Exception caught ! " << std::endl;
+        std::cerr << excp << std::endl;
+        MPI_Abort( MPI_COMM_WORLD, EXIT_FAILURE );
+        }
+
+      // the slowest rank determines the time of each phase
+      double global[NumberOfPhases];
+      double globalBytes = 0.0;
+      MPI_Reduce( local, global, NumberOfPhases, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD );
+      MPI_Reduce( &bytes, &globalBytes, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD );
+
+      if ( rank == 0 && global[TotalPhase] < best[TotalPhase] )
+        {
+        std::copy( global, global + NumberOfPhases, best );
+        bestBytes = globalBytes;
+        }
+      }
+
+    if ( rank == 0 )
+      {
+      const double exchangeTime = best[StartPhase] + best[FinishPhase];
+      std::cout << "{ \"benchmark\": \"MPIStreamingImageFilter\""
+                << ", \"scaling\": \"" << ( weakScaling ? "weak" : "strong" ) << "\""
+                << ", \"pattern\": \"" << pattern << "\""
+                << ", \"ranks\": " << size
+                << ", \"size\": [" << sourceSize[0] << ", " << sourceSize[1] << ", " << sourceSize[2] << "]"
+                << ", \"halo\": " << ( pattern == "halo" ? halo : 0 );
+      for ( unsigned int phase = 0; phase < NumberOfPhases; ++phase )
+        {
+        std::cout << ", \"" << PhaseNames[phase] << "_seconds\": " << best[phase];
+        }
+      std::cout << ", \"bytes_received\": " << bestBytes
+                << ", \"bandwidth_bytes_per_second\": " << ( exchangeTime > 0.0 ? bestBytes / exchangeTime : 0.0 )
+                << " }" << std::endl;
+      }
+    }
+
+  MPI_Finalize();
+
+  return status;
+}
@@ -21,11 +21,30 @@
 
 #include "itkImageFileReader.h"
 #include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include <cstring>
 
 int itkMPIStreamingImageFilterTest( int argc, char *argv[] )
 {
+  // with "hybrid" the communication is progressed by a separate
+  // thread, with "halo" each rank also requests its own slab with a
+  // halo, with "replicate" every rank produces the whole image, and
+  // with "async" two split-phase updates are pipelined
+  const bool halo = ( argc > 2 && std::strcmp( argv[2], "halo" ) == 0 );
+  const bool hybrid = halo || ( argc > 2 && std::strcmp( argv[2], "hybrid" ) == 0 );
+  const bool replicate = ( argc > 2 && std::strcmp( argv[2], "replicate" ) == 0 );
+  const bool async = ( argc > 2 && std::strcmp( argv[2], "async" ) == 0 );
 
-  MPI_Init( &argc, &argv );
+  if ( hybrid )
+    {
+    int provided;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
+    }
+  else
+    {
+    MPI_Init( &argc, &argv );
+    }
 
   typedef itk::Image< float, 3 > ImageType;
 
@@ -36,22 +55,108 @@ int itkMPIStreamingImageFilterTest( int argc, char *argv[] )
   typedef itk::MPIStreamingImageFilter<ImageType> MPIStreamerType;
   MPIStreamerType::Pointer streamer = MPIStreamerType::New();
   streamer->SetInput( reader->GetOutput() );
+  streamer->SetUseCommunicationThread( hybrid );
+  streamer->SetReplicateOutput( replicate );
 
   int rank;
   MPI_Comm_rank( MPI_COMM_WORLD, &rank );
 
-  std::ostringstream ss;
-  ss << "mpi" << rank << ".mha";
+  int size;
+  MPI_Comm_size( MPI_COMM_WORLD, &size );
 
-  typedef itk::ImageFileWriter< ImageType > WriterType;
-  WriterType::Pointer writer = WriterType::New();
-  writer->SetFileName( ss.str().c_str() );
-  writer->SetInput( streamer->GetOutput() );
-  writer->SetNumberOfStreamDivisions( 2 );
-  writer->Update();
+  std::vector< ImageType::ConstPointer > results;
+  std::vector< ImageType::RegionType >   expectedRegions;
+  if ( halo )
+    {
+    // The requested regions differ between the ranks, so the regions
+    // are sent point to point while the thread progresses them.
+    reader->UpdateOutputInformation();
+    const ImageType::RegionType largestRegion = reader->GetOutput()->GetLargestPossibleRegion();
 
+    itk::ImageRegionSplitterSlowDimension::Pointer splitter = itk::ImageRegionSplitterSlowDimension::New();
+    const unsigned int numberOfSplits = splitter->GetNumberOfSplits( largestRegion, size );
+    ImageType::RegionType region = largestRegion;
+    if ( static_cast< unsigned int >( rank ) < numberOfSplits )
+      {
+      splitter->GetSplit( rank, numberOfSplits, region );
+      }
+    else
+      {
+      region.SetSize( ImageType::ImageDimension - 1, 1 );
+      }
+
+    ImageType::SizeType radius;
+    radius.Fill( 0 );
+    radius[ImageType::ImageDimension - 1] = 2;
+    region.PadByRadius( radius );
+    region.Crop( largestRegion );
+
+    streamer->GetOutput()->SetRequestedRegion( region );
+    streamer->Update();
+    results.push_back( streamer->GetOutput() );
+    expectedRegions.push_back( region );
+    }
+  else if ( async )
+    {
+    // the second exchange is posted while the first is pending
+    MPIStreamerType::UpdateHandleType handle1 = streamer->StartUpdate();
+    MPIStreamerType::UpdateHandleType handle2 = streamer->StartUpdate();
+    results.push_back( streamer->FinishUpdate( handle1 ).GetPointer() );
+    results.push_back( streamer->FinishUpdate( handle2 ).GetPointer() );
+    }
+  else
+    {
+    std::ostringstream ss;
+    ss << "mpi" << rank << ".mha";
+
+    typedef itk::ImageFileWriter< ImageType > WriterType;
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetFileName( ss.str().c_str() );
+    writer->SetInput( streamer->GetOutput() );
+    writer->SetNumberOfStreamDivisions( 2 );
+    writer->Update();
+
+    if ( replicate )
+      {
+      results.push_back( streamer->GetOutput() );
+      }
+    }
+
+  int status = EXIT_SUCCESS;
+  if ( !results.empty() )
+    {
+    ReaderType::Pointer reference = ReaderType::New();
+    reference->SetFileName( argv[1] );
+    reference->Update();
+
+    for ( size_t i = 0; i < results.size(); ++i )
+      {
+      const ImageType * output = results[i];
+      const ImageType::RegionType expectedRegion =
+        ( i < expectedRegions.size() ) ? expectedRegions[i] : reference->GetOutput()->GetLargestPossibleRegion();
+      if ( output->GetBufferedRegion() != expectedRegion )
+        {
+        std::cerr << "RANK " << rank << ": The output is not the expected region " << expectedRegion << ": "
+                  << output->GetBufferedRegion() << std::endl;
+        status = EXIT_FAILURE;
+        continue;
+        }
+
+      itk::ImageRegionConstIterator< ImageType > outIt( output, output->GetBufferedRegion() );
+      itk::ImageRegionConstIterator< ImageType > refIt( reference->GetOutput(), output->GetBufferedRegion() );
+      for ( ; !outIt.IsAtEnd(); ++outIt, ++refIt )
+        {
+        if ( outIt.Get() != refIt.Get() )
+          {
+          std::cerr << "RANK " << rank << ": Mismatch at " << outIt.GetIndex() << std::endl;
+          status = EXIT_FAILURE;
+          break;
+          }
+        }
+      }
+    }
 
   MPI_Finalize();
 
-  return 0;
+  return status;
 }
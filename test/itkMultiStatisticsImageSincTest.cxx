@@ -0,0 +1,187 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "itkImage.h"
+#include "itkMultiStatisticsImageSinc.h"
+#include "itkStatisticsImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageFileReader.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+// A filter which requests the largest possible region of its input,
+// so the buffered region of the sink's input is larger than the piece.
+template< class TImage >
+class EnlargeRequestedRegionImageFilter
+  : public itk::CastImageFilter< TImage, TImage >
+{
+public:
+  typedef EnlargeRequestedRegionImageFilter         Self;
+  typedef itk::CastImageFilter< TImage, TImage >    Superclass;
+  typedef itk::SmartPointer< Self >                 Pointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(EnlargeRequestedRegionImageFilter, CastImageFilter);
+
+protected:
+  EnlargeRequestedRegionImageFilter()
+    {
+      this->InPlaceOff();
+    }
+
+  void EnlargeOutputRequestedRegion( itk::DataObject *output ) override
+    {
+      Superclass::EnlargeOutputRequestedRegion( output );
+      output->SetRequestedRegionToLargestPossibleRegion();
+    }
+};
+
+} // end namespace
+
+int itkMultiStatisticsImageSincTest(int argc, char* argv[] )
+{
+
+  if( argc < 3 )
+    {
+    std::cerr << "Missing Arguments" << std::endl;
+    std::cerr << "Usage: " << std::endl;
+    std::cerr << argv[0] << " inputImage numberOfStreamDivisions [numberOfChunksPerWorkUnit] [enlargeRequestedRegion]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  unsigned int numberOfStreamDivisions = std::max( atoi( argv[2] ), 1 );
+  unsigned int numberOfChunksPerWorkUnit = 1;
+  if ( argc > 3 )
+    {
+    numberOfChunksPerWorkUnit = std::max( atoi( argv[3] ), 1 );
+    }
+  bool enlargeRequestedRegion = false;
+  if ( argc > 4 )
+    {
+    enlargeRequestedRegion = ( atoi( argv[4] ) != 0 );
+    }
+
+  typedef itk::Image<unsigned char,2> ImageType;
+
+  typedef itk::ImageFileReader< ImageType >    ReaderType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+
+  reader->SetFileName( argv[1] );
+
+  typedef itk::MultiStatisticsImageSinc<ImageType> StatisticsFilterType;
+  StatisticsFilterType::Pointer filter = StatisticsFilterType::New();
+
+  EXERCISE_BASIC_OBJECT_METHODS( filter, MultiStatisticsImageSinc, StreamingImageSinc );
+
+  TEST_SET_GET_BOOLEAN( filter, ComputeBoundingRegion, true );
+  TEST_SET_GET_BOOLEAN( filter, ComputeMinimumMaximum, true );
+  TEST_SET_GET_BOOLEAN( filter, ComputeMeanVariance, true );
+  TEST_SET_GET_BOOLEAN( filter, ComputeHistogram, true );
+
+  typedef EnlargeRequestedRegionImageFilter< ImageType > EnlargeFilterType;
+  EnlargeFilterType::Pointer enlarge = EnlargeFilterType::New();
+  enlarge->SetInput( reader->GetOutput() );
+
+  if ( enlargeRequestedRegion )
+    {
+    filter->SetInput( enlarge->GetOutput() );
+    }
+  else
+    {
+    filter->SetInput( reader->GetOutput() );
+    }
+  filter->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  filter->SetNumberOfChunksPerWorkUnit( numberOfChunksPerWorkUnit );
+
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  std::cout << "Minimum: " << static_cast<int>( filter->GetMinimum() ) << std::endl;
+  std::cout << "Maximum: " << static_cast<int>( filter->GetMaximum() ) << std::endl;
+  std::cout << "Mean: " << filter->GetMean() << std::endl;
+  std::cout << "Variance: " << filter->GetVariance() << std::endl;
+
+  // compare with the non-streamed statistics
+  typedef itk::StatisticsImageFilter< ImageType > ReferenceFilterType;
+  ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+  reference->SetInput( reader->GetOutput() );
+  reference->Update();
+
+  // relative tolerance
+  const double tolerance = 1e-8;
+
+  TEST_EXPECT_EQUAL( filter->GetMinimum(), reference->GetMinimum() );
+  TEST_EXPECT_EQUAL( filter->GetMaximum(), reference->GetMaximum() );
+  TEST_EXPECT_TRUE( std::abs( filter->GetMean() - reference->GetMean() ) <= tolerance * reference->GetMean() );
+  TEST_EXPECT_TRUE( std::abs( filter->GetVariance() - reference->GetVariance() ) <= tolerance * reference->GetVariance() );
+  // the sum of an integer image is exact
+  TEST_EXPECT_EQUAL( filter->GetSum(), reference->GetSum() );
+
+  const itk::SizeValueType numberOfPixels = reader->GetOutput()->GetLargestPossibleRegion().GetNumberOfPixels();
+  TEST_EXPECT_EQUAL( filter->GetCount(), numberOfPixels );
+  TEST_EXPECT_EQUAL( filter->GetHistogram()->GetSize(0), 256u );
+  TEST_EXPECT_EQUAL( filter->GetHistogram()->GetTotalFrequency(), numberOfPixels );
+
+  // count the pixels in the bins of the histogram, the upper bound is
+  // included in the last bin
+  typedef StatisticsFilterType::HistogramType HistogramType;
+  const HistogramType *histogram = filter->GetHistogram();
+  std::vector< itk::SizeValueType > expectedFrequency( histogram->GetSize(0), 0 );
+  itk::ImageRegionConstIterator< ImageType > it( reader->GetOutput(), reader->GetOutput()->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    HistogramType::MeasurementVectorType measurement( 1 );
+    measurement[0] = it.Get();
+    HistogramType::IndexType index( 1 );
+    if ( histogram->GetIndex( measurement, index ) )
+      {
+      ++expectedFrequency[ index[0] ];
+      }
+    else if ( measurement[0] == filter->GetHistogramUpperBound() )
+      {
+      ++expectedFrequency.back();
+      }
+    }
+  for ( unsigned int bin = 0; bin < expectedFrequency.size(); ++bin )
+    {
+    TEST_EXPECT_EQUAL( histogram->GetFrequency( bin ), expectedFrequency[bin] );
+    }
+
+  const StatisticsFilterType::RegionType region = filter->GetRegion();
+
+  // the statistics which are no longer computed are reset
+  filter->ComputeMeanVarianceOff();
+  filter->ComputeHistogramOff();
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_EQUAL( filter->GetRegion(), region );
+  TEST_EXPECT_EQUAL( filter->GetMinimum(), reference->GetMinimum() );
+  TEST_EXPECT_EQUAL( filter->GetMean(), 0.0 );
+  TEST_EXPECT_EQUAL( filter->GetVariance(), 0.0 );
+  TEST_EXPECT_EQUAL( filter->GetSum(), 0.0 );
+  TEST_EXPECT_EQUAL( filter->GetHistogram()->GetSize(0), 0u );
+
+  // printed last, the test passes by matching the region
+  std::cout << "Region: " << region.GetIndex()
+            << " " << region.GetSize() << std::endl;
+
+  return EXIT_SUCCESS;
+}
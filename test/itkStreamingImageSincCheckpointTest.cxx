@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "itkImage.h"
+#include "itkBoundingRegionImageSinc.h"
+#include "itkImageFileReader.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+namespace
+{
+
+// Count the pieces streamed by each update.
+template< class TInputImage >
+class CountingBoundingRegionImageSinc
+  : public itk::BoundingRegionImageSinc< TInputImage >
+{
+public:
+  typedef CountingBoundingRegionImageSinc                Self;
+  typedef itk::BoundingRegionImageSinc< TInputImage >    Superclass;
+  typedef itk::SmartPointer< Self >                      Pointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(CountingBoundingRegionImageSinc, BoundingRegionImageSinc);
+
+  unsigned int GetNumberOfStreamedPieces() const
+    { return m_NumberOfStreamedPieces; }
+
+protected:
+  CountingBoundingRegionImageSinc() : m_NumberOfStreamedPieces(0) {}
+
+  void BeforeStreamedGenerateData() override
+    {
+      m_NumberOfStreamedPieces = 0;
+      Superclass::BeforeStreamedGenerateData();
+    }
+
+  void StreamedGenerateData( unsigned int inputRequestedRegionNumber ) override
+    {
+      ++m_NumberOfStreamedPieces;
+      Superclass::StreamedGenerateData( inputRequestedRegionNumber );
+    }
+
+private:
+  unsigned int m_NumberOfStreamedPieces;
+};
+
+} // end namespace
+
+int itkStreamingImageSincCheckpointTest(int argc, char* argv[] )
+{
+
+  if( argc < 3 )
+    {
+    std::cerr << "Missing Arguments" << std::endl;
+    std::cerr << "Usage: " << std::endl;
+    std::cerr << argv[0] << " inputImage checkpointFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string checkpointFileName = argv[2];
+  itksys::SystemTools::RemoveFile( checkpointFileName );
+
+  typedef itk::Image<unsigned char,2> ImageType;
+
+  typedef itk::ImageFileReader< ImageType >    ReaderType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+
+  reader->SetFileName( argv[1] );
+
+  typedef CountingBoundingRegionImageSinc<ImageType> RegionFilterType;
+  RegionFilterType::Pointer filter = RegionFilterType::New();
+
+  filter->SetInput(reader->GetOutput());
+  filter->SetNumberOfStreamDivisions( 8 );
+  filter->SetNumberOfChunksPerWorkUnit( 2 );
+  filter->SetCheckpointFileName( checkpointFileName );
+  filter->SetCheckpointPieceInterval( 1 );
+
+  // abort after half the pieces
+  RegionFilterType *rawFilter = filter.GetPointer();
+  const unsigned long tag = filter->AddObserver( itk::ProgressEvent(), [rawFilter]( const itk::EventObject & )
+    {
+      if ( rawFilter->GetProgress() >= 0.5 )
+        {
+        rawFilter->AbortGenerateDataOn();
+        }
+    } );
+
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_TRUE( itksys::SystemTools::FileExists( checkpointFileName ) );
+
+  const unsigned int numberOfPiecesBeforeAbort = filter->GetNumberOfStreamedPieces();
+  const RegionFilterType::RegionType partialRegion = filter->GetRegion();
+  std::cout << "Partial region: " << partialRegion.GetIndex()
+            << " " << partialRegion.GetSize() << std::endl;
+  TEST_EXPECT_TRUE( numberOfPiecesBeforeAbort > 0 && numberOfPiecesBeforeAbort < 8 );
+
+  // resume
+  filter->RemoveObserver( tag );
+  filter->Modified();
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_TRUE( !itksys::SystemTools::FileExists( checkpointFileName ) );
+
+  // only the remaining pieces are streamed
+  std::cout << "Pieces streamed: " << numberOfPiecesBeforeAbort << " + "
+            << filter->GetNumberOfStreamedPieces() << std::endl;
+  TEST_EXPECT_EQUAL( numberOfPiecesBeforeAbort + filter->GetNumberOfStreamedPieces(), 8u );
+  TEST_EXPECT_TRUE( partialRegion != filter->GetRegion() );
+
+  std::cout << "Region: " << filter->GetRegion().GetIndex()
+            << " " << filter->GetRegion().GetSize() << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "itkImage.h"
+#include "itkBoundingRegionImageSinc.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+// Record the piece order of the last update.
+template< class TInputImage >
+class PieceOrderBoundingRegionImageSinc
+  : public itk::BoundingRegionImageSinc< TInputImage >
+{
+public:
+  typedef PieceOrderBoundingRegionImageSinc              Self;
+  typedef itk::BoundingRegionImageSinc< TInputImage >    Superclass;
+  typedef itk::SmartPointer< Self >                      Pointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(PieceOrderBoundingRegionImageSinc, BoundingRegionImageSinc);
+
+  const std::vector< unsigned int > & GetGeneratedPieceOrder() const
+    { return m_GeneratedPieceOrder; }
+
+  static std::uint64_t Key( std::uint64_t x0, std::uint64_t x1, unsigned int numberOfBits, bool hilbert )
+    {
+      std::uint64_t x[2] = { x0, x1 };
+      return Superclass::SpaceFillingCurveKey( x, 2, numberOfBits, hilbert );
+    }
+
+protected:
+  PieceOrderBoundingRegionImageSinc() {}
+
+  void GeneratePieceOrder( std::vector< unsigned int > & order ) override
+    {
+      Superclass::GeneratePieceOrder( order );
+      m_GeneratedPieceOrder = order;
+    }
+
+private:
+  std::vector< unsigned int > m_GeneratedPieceOrder;
+};
+
+// The cells of a 4x4 grid along each curve, as [x0, x1].
+const unsigned int MortonCurve[16][2] = {
+  {0,0}, {0,1}, {1,0}, {1,1}, {0,2}, {0,3}, {1,2}, {1,3},
+  {2,0}, {2,1}, {3,0}, {3,1}, {2,2}, {2,3}, {3,2}, {3,3} };
+
+const unsigned int HilbertCurve[16][2] = {
+  {0,0}, {1,0}, {1,1}, {0,1}, {0,2}, {0,3}, {1,3}, {1,2},
+  {2,2}, {2,3}, {3,3}, {3,2}, {3,1}, {2,1}, {2,0}, {3,0} };
+
+} // end namespace
+
+int itkStreamingImageSincPieceOrderTest(int, char* [] )
+{
+  typedef itk::Image<unsigned char,2>                       ImageType;
+  typedef PieceOrderBoundingRegionImageSinc< ImageType >    FilterType;
+
+  // the keys of the cells of a 4x4 grid are their positions along the
+  // curves
+  for ( unsigned int k = 0; k < 16; ++k )
+    {
+    TEST_EXPECT_EQUAL( FilterType::Key( MortonCurve[k][0], MortonCurve[k][1], 2, false ), k );
+    TEST_EXPECT_EQUAL( FilterType::Key( HilbertCurve[k][0], HilbertCurve[k][1], 2, true ), k );
+    }
+
+  // a 64x64 image split in 4x4 pieces of 16x16
+  ImageType::Pointer image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetIndex( 0, 10 );
+  region.SetIndex( 1, -5 );
+  region.SetSize( 0, 64 );
+  region.SetSize( 1, 64 );
+  image->SetRegions( region );
+  image->Allocate( true );
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetNumberOfStreamDivisions( 16 );
+  filter->SetRegionSplitter( itk::ImageRegionSplitterMultidimensional::New() );
+
+  // the cell of the grid of each piece
+  std::vector< unsigned int > cells( 16 );
+  for ( unsigned int piece = 0; piece < 16; ++piece )
+    {
+    ImageType::RegionType pieceRegion = region;
+    filter->GetRegionSplitter()->GetSplit( piece, 16, pieceRegion );
+    TEST_EXPECT_EQUAL( pieceRegion.GetSize( 0 ), 16u );
+    TEST_EXPECT_EQUAL( pieceRegion.GetSize( 1 ), 16u );
+    const unsigned int x0 = ( pieceRegion.GetIndex( 0 ) - region.GetIndex( 0 ) ) / 16;
+    const unsigned int x1 = ( pieceRegion.GetIndex( 1 ) - region.GetIndex( 1 ) ) / 16;
+    cells[piece] = x0 + 4 * x1;
+    }
+
+  // the pieces follow the curves
+  filter->SetPieceOrder( FilterType::MortonPieceOrder );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_EQUAL( filter->GetGeneratedPieceOrder().size(), 16u );
+  for ( unsigned int k = 0; k < 16; ++k )
+    {
+    TEST_EXPECT_EQUAL( cells[ filter->GetGeneratedPieceOrder()[k] ], MortonCurve[k][0] + 4 * MortonCurve[k][1] );
+    }
+
+  filter->SetPieceOrder( FilterType::HilbertPieceOrder );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_EQUAL( filter->GetGeneratedPieceOrder().size(), 16u );
+  for ( unsigned int k = 0; k < 16; ++k )
+    {
+    TEST_EXPECT_EQUAL( cells[ filter->GetGeneratedPieceOrder()[k] ], HilbertCurve[k][0] + 4 * HilbertCurve[k][1] );
+    }
+
+  // With tiles of 32x32 the pieces are grouped by their tile, with the
+  // first dimension fastest, and keep their natural order in a tile,
+  // which differs from the natural order of the 4x4 pieces.
+  FilterType::SizeType tileSize;
+  tileSize.Fill( 32 );
+  filter->SetPieceOrder( FilterType::TilePieceOrder );
+  filter->SetPieceOrderTileSize( tileSize );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  const std::vector< unsigned int > & order = filter->GetGeneratedPieceOrder();
+  TEST_EXPECT_EQUAL( order.size(), 16u );
+
+  bool natural = true;
+  for ( unsigned int k = 0; k < 16; ++k )
+    {
+    natural = natural && ( order[k] == k );
+    const unsigned int tile = ( cells[order[k]] % 4 ) / 2 + 2 * ( cells[order[k]] / 8 );
+    TEST_EXPECT_EQUAL( tile, k / 4 );
+    if ( k % 4 != 0 )
+      {
+      TEST_EXPECT_TRUE( order[k-1] < order[k] );
+      }
+    }
+  TEST_EXPECT_TRUE( !natural );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
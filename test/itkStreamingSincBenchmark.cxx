@@ -0,0 +1,405 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// Benchmark of the streaming sinks on synthetic masks.
+//
+// Usage:
+//   itkStreamingSincBenchmark [--dimension 2|3] [--size n]
+//     [--pattern sparse,dense,random,shell] [--sink bounding,bitpacked,statistics]
+//     [--divisions 1,4,16,64] [--threads 1,n] [--chunks c] [--repeat r]
+//
+// The masks are generated for each piece, so a 3D mask of several GB,
+// such as --size 2048, only needs the memory of one piece. The results
+// are written as JSON to the standard output. The time of the sink
+// excludes the time to generate the mask, which is reported
+// separately, and the voxels per second are those of the sink. The
+// per-piece overhead is the additional sink time of each piece over
+// the smallest number of stream divisions with the same number of
+// threads, counting the pieces actually streamed. The number of
+// threads is the default number of threads of the filters, and their
+// number of work units.
+
+#include "itkImage.h"
+#include "itkBoundingRegionImageSinc.h"
+#include "itkBitPackedBoundingRegionImageSinc.h"
+#include "itkBinaryImageToBitPackedImageFilter.h"
+#include "itkMultiStatisticsImageSinc.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSyntheticMaskImageSource.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct BenchmarkOptions
+{
+  unsigned int                Dimension = 3;
+  unsigned int                Size = 256;
+  std::vector< std::string >  Patterns = { "sparse", "dense", "random", "shell" };
+  std::vector< std::string >  Sinks = { "bounding", "bitpacked", "statistics" };
+  std::vector< unsigned int > Divisions = { 1, 4, 16, 64 };
+  std::vector< unsigned int > Threads;
+  unsigned int                Chunks = 1;
+  unsigned int                Repeat = 3;
+};
+
+
+std::vector< std::string > SplitList( const std::string & list )
+{
+  std::vector< std::string > items;
+  std::istringstream ss( list );
+  std::string item;
+  while ( std::getline( ss, item, ',' ) )
+    {
+    if ( !item.empty() )
+      {
+      items.push_back( item );
+      }
+    }
+  return items;
+}
+
+
+std::vector< unsigned int > SplitNumberList( const std::string & list )
+{
+  std::vector< unsigned int > numbers;
+  const std::vector< std::string > items = SplitList( list );
+  for ( size_t i = 0; i < items.size(); ++i )
+    {
+    numbers.push_back( std::max( atoi( items[i].c_str() ), 1 ) );
+    }
+  return numbers;
+}
+
+
+template< class TSink >
+void ConfigureSink( TSink *sink, unsigned int divisions, unsigned int threads, unsigned int chunks )
+{
+  sink->SetNumberOfStreamDivisions( divisions );
+  sink->SetNumberOfWorkUnits( threads );
+  sink->SetNumberOfChunksPerWorkUnit( chunks );
+}
+
+
+// The number of pieces the sink actually streams, which may be less
+// than the requested number of stream divisions.
+template< class TSink >
+unsigned int GetNumberOfPieces( TSink *sink )
+{
+  return sink->GetRegionSplitter()->GetNumberOfSplits( sink->GetInput()->GetLargestPossibleRegion(),
+                                                       sink->GetNumberOfStreamDivisions() );
+}
+
+
+// The times of the repetition with the fastest sink.
+struct SinkResult
+{
+  double       SinkSeconds = -1.0;
+  double       GenerateSeconds = 0.0;
+  unsigned int NumberOfPieces = 0;
+};
+
+
+// Run one configuration. The time of the sink excludes the generation
+// of the mask, and of the packed image, for each piece.
+template< unsigned int VDimension >
+SinkResult RunSink( const std::string & sinkName,
+                    const std::string & patternName,
+                    unsigned int size,
+                    unsigned int divisions,
+                    unsigned int threads,
+                    unsigned int chunks,
+                    unsigned int repeat )
+{
+  typedef itk::Image< unsigned char, VDimension >                  MaskImageType;
+  typedef itk::SyntheticMaskImageSource< MaskImageType >           SourceType;
+  typedef itk::BinaryImageToBitPackedImageFilter< MaskImageType >  PackerType;
+  typedef typename PackerType::OutputImageType                     PackedImageType;
+
+  // the filters created below use this number of threads
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads( threads );
+
+  SinkResult best;
+  for ( unsigned int r = 0; r < repeat; ++r )
+    {
+    typename SourceType::Pointer source = SourceType::New();
+    typename SourceType::SizeType sourceSize;
+    sourceSize.Fill( size );
+    source->SetSize( sourceSize );
+    source->SetPatternName( patternName );
+    source->SetNumberOfWorkUnits( threads );
+
+    // time the generation of each piece, the packer is executed after
+    // the source so their times do not overlap
+    std::chrono::steady_clock::time_point generateStart;
+    double generateSeconds = 0.0;
+    const auto startGenerate = [&generateStart]( const itk::EventObject & )
+      { generateStart = std::chrono::steady_clock::now(); };
+    const auto endGenerate = [&generateStart, &generateSeconds]( const itk::EventObject & )
+      {
+        const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - generateStart;
+        generateSeconds += elapsed.count();
+      };
+    source->AddObserver( itk::StartEvent(), startGenerate );
+    source->AddObserver( itk::EndEvent(), endGenerate );
+
+    // the pipeline does not keep the packer alive
+    typename PackerType::Pointer packer;
+
+    itk::ProcessObject::Pointer sink;
+    unsigned int numberOfPieces = 0;
+    if ( sinkName == "bounding" )
+      {
+      typename itk::BoundingRegionImageSinc< MaskImageType >::Pointer filter =
+        itk::BoundingRegionImageSinc< MaskImageType >::New();
+      filter->SetInput( source->GetOutput() );
+      ConfigureSink( filter.GetPointer(), divisions, threads, chunks );
+      filter->UpdateOutputInformation();
+      numberOfPieces = GetNumberOfPieces( filter.GetPointer() );
+      sink = filter;
+      }
+    else if ( sinkName == "bitpacked" )
+      {
+      packer = PackerType::New();
+      packer->SetInput( source->GetOutput() );
+      packer->SetNumberOfWorkUnits( threads );
+      packer->AddObserver( itk::StartEvent(), startGenerate );
+      packer->AddObserver( itk::EndEvent(), endGenerate );
+      typename itk::BitPackedBoundingRegionImageSinc< PackedImageType >::Pointer filter =
+        itk::BitPackedBoundingRegionImageSinc< PackedImageType >::New();
+      filter->SetInput( packer->GetOutput() );
+      ConfigureSink( filter.GetPointer(), divisions, threads, chunks );
+      filter->UpdateOutputInformation();
+      numberOfPieces = GetNumberOfPieces( filter.GetPointer() );
+      sink = filter;
+      }
+    else if ( sinkName == "statistics" )
+      {
+      typename itk::MultiStatisticsImageSinc< MaskImageType >::Pointer filter =
+        itk::MultiStatisticsImageSinc< MaskImageType >::New();
+      filter->SetInput( source->GetOutput() );
+      ConfigureSink( filter.GetPointer(), divisions, threads, chunks );
+      filter->UpdateOutputInformation();
+      numberOfPieces = GetNumberOfPieces( filter.GetPointer() );
+      sink = filter;
+      }
+    else
+      {
+      std::cerr << "Unknown sink: " << sinkName << std::endl;
+      return SinkResult();
+      }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    sink->Update();
+    const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+
+    const double sinkSeconds = std::max( elapsed.count() - generateSeconds, 0.0 );
+    if ( best.SinkSeconds < 0.0 || sinkSeconds < best.SinkSeconds )
+      {
+      best.SinkSeconds = sinkSeconds;
+      best.GenerateSeconds = generateSeconds;
+      best.NumberOfPieces = numberOfPieces;
+      }
+    }
+  return best;
+}
+
+
+template< unsigned int VDimension >
+int RunBenchmark( const BenchmarkOptions & options )
+{
+  itk::SizeValueType numberOfVoxels = 1;
+  for ( unsigned int i = 0; i < VDimension; ++i )
+    {
+    numberOfVoxels *= options.Size;
+    }
+
+  std::cout << "{" << std::endl;
+  std::cout << "  \"benchmark\": \"StreamingSinc\"," << std::endl;
+  std::cout << "  \"dimension\": " << VDimension << "," << std::endl;
+  std::cout << "  \"size\": " << options.Size << "," << std::endl;
+  std::cout << "  \"voxels\": " << numberOfVoxels << "," << std::endl;
+  std::cout << "  \"chunks_per_work_unit\": " << options.Chunks << "," << std::endl;
+  std::cout << "  \"results\": [" << std::endl;
+
+  bool first = true;
+  for ( size_t s = 0; s < options.Sinks.size(); ++s )
+    {
+    for ( size_t p = 0; p < options.Patterns.size(); ++p )
+      {
+      for ( size_t t = 0; t < options.Threads.size(); ++t )
+        {
+        // the divisions are sorted, so the first is the baseline
+        SinkResult baseline;
+        for ( size_t d = 0; d < options.Divisions.size(); ++d )
+          {
+          const unsigned int divisions = options.Divisions[d];
+          const SinkResult result = RunSink< VDimension >( options.Sinks[s], options.Patterns[p], options.Size,
+                                                           divisions, options.Threads[t],
+                                                           options.Chunks, options.Repeat );
+          if ( result.SinkSeconds < 0.0 )
+            {
+            return EXIT_FAILURE;
+            }
+
+          if ( d == 0 )
+            {
+            baseline = result;
+            }
+
+          // the splitter may stream fewer pieces than the divisions
+          double perPieceOverhead = 0.0;
+          if ( result.NumberOfPieces > baseline.NumberOfPieces )
+            {
+            perPieceOverhead = ( result.SinkSeconds - baseline.SinkSeconds )
+              / ( result.NumberOfPieces - baseline.NumberOfPieces );
+            }
+
+          std::cout << ( first ? "" : ",\n" );
+          std::cout << "    { \"sink\": \"" << options.Sinks[s] << "\""
+                    << ", \"pattern\": \"" << options.Patterns[p] << "\""
+                    << ", \"stream_divisions\": " << divisions
+                    << ", \"pieces\": " << result.NumberOfPieces
+                    << ", \"threads\": " << options.Threads[t]
+                    << ", \"sink_seconds\": " << result.SinkSeconds
+                    << ", \"generate_seconds\": " << result.GenerateSeconds
+                    << ", \"voxels_per_second\": "
+                    << ( result.SinkSeconds > 0.0 ? numberOfVoxels / result.SinkSeconds : 0.0 )
+                    << ", \"per_piece_overhead_seconds\": " << perPieceOverhead
+                    << " }";
+          first = false;
+          }
+        }
+      }
+    }
+
+  std::cout << "\n  ]" << std::endl;
+  std::cout << "}" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+} // end namespace
+
+
+int main( int argc, char *argv[] )
+{
+  BenchmarkOptions options;
+  options.Threads.push_back( 1 );
+  if ( itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() > 1 )
+    {
+    options.Threads.push_back( itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() );
+    }
+
+  for ( int i = 1; i + 1 < argc; i += 2 )
+    {
+    const std::string option = argv[i];
+    const std::string value = argv[i+1];
+    if ( option == "--dimension" )
+      {
+      options.Dimension = atoi( value.c_str() );
+      }
+    else if ( option == "--size" )
+      {
+      options.Size = std::max( atoi( value.c_str() ), 1 );
+      }
+    else if ( option == "--pattern" )
+      {
+      options.Patterns = SplitList( value );
+      }
+    else if ( option == "--sink" )
+      {
+      options.Sinks = SplitList( value );
+      }
+    else if ( option == "--divisions" )
+      {
+      options.Divisions = SplitNumberList( value );
+      }
+    else if ( option == "--threads" )
+      {
+      options.Threads = SplitNumberList( value );
+      }
+    else if ( option == "--chunks" )
+      {
+      options.Chunks = std::max( atoi( value.c_str() ), 1 );
+      }
+    else if ( option == "--repeat" )
+      {
+      options.Repeat = std::max( atoi( value.c_str() ), 1 );
+      }
+    else
+      {
+      std::cerr << "Unknown option: " << option << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if ( options.Divisions.empty() || options.Threads.empty() )
+    {
+    std::cerr << "No divisions or threads" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::sort( options.Divisions.begin(), options.Divisions.end() );
+  options.Divisions.erase( std::unique( options.Divisions.begin(), options.Divisions.end() ), options.Divisions.end() );
+
+  // the threads are limited by the global maximum number of threads
+  unsigned int maximumThreads = 1;
+  for ( size_t t = 0; t < options.Threads.size(); ++t )
+    {
+    maximumThreads = std::max( maximumThreads, options.Threads[t] );
+    }
+  if ( itk::MultiThreaderBase::GetGlobalMaximumNumberOfThreads() < maximumThreads )
+    {
+    itk::MultiThreaderBase::SetGlobalMaximumNumberOfThreads( maximumThreads );
+    }
+
+  for ( size_t p = 0; p < options.Patterns.size(); ++p )
+    {
+    if ( !itk::SyntheticMaskImageSource< itk::Image< unsigned char, 2 > >::New()->SetPatternName( options.Patterns[p] ) )
+      {
+      std::cerr << "Unknown pattern: " << options.Patterns[p] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  try
+    {
+    switch ( options.Dimension )
+      {
+      case 2:
+        return RunBenchmark< 2 >( options );
+      case 3:
+        return RunBenchmark< 3 >( options );
+      default:
+        std::cerr << "Unsupported dimension: " << options.Dimension << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  catch ( itk::ExceptionObject & excp )
+    {
+    std::cerr << "Exception caught ! " << std::endl;
+    std::cerr << excp << std::endl;
+    return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,201 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSyntheticMaskImageSource_h
+#define itkSyntheticMaskImageSource_h
+
+#include "itkImageSource.h"
+#include "itkImageScanlineIterator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+namespace itk
+{
+
+/** \class SyntheticMaskImageSource
+ *
+ * \brief Generate a synthetic mask of any size for the benchmarks.
+ *
+ * The value of each pixel is computed from its index, so only the
+ * requested region is allocated and images larger than the memory can
+ * be streamed. The patterns are:
+ *  - sparse: about one pixel in 4096 is set, at pseudo-random positions;
+ *  - dense: all the pixels are set;
+ *  - random: about half of the pixels are set, at pseudo-random positions;
+ *  - shell: a spherical shell of two pixels of thickness, centered in
+ *    the image, with a radius of 0.4 of the smallest size.
+ *
+ * \ingroup StreamingSinc
+ **/
+template< class TOutputImage >
+class SyntheticMaskImageSource
+  : public ImageSource< TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef SyntheticMaskImageSource      Self;
+  typedef ImageSource< TOutputImage >   Superclass;
+  typedef SmartPointer< Self >          Pointer;
+  typedef SmartPointer< const Self >    ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(SyntheticMaskImageSource, ImageSource);
+
+  typedef TOutputImage                          OutputImageType;
+  typedef typename OutputImageType::RegionType  RegionType;
+  typedef typename OutputImageType::SizeType    SizeType;
+  typedef typename OutputImageType::PixelType   PixelType;
+
+  typedef enum
+    {
+    SparsePattern = 0,
+    DensePattern,
+    RandomPattern,
+    ShellPattern
+    } PatternType;
+
+  itkSetMacro(Size, SizeType);
+  itkGetConstReferenceMacro(Size, SizeType);
+
+  itkSetMacro(Pattern, PatternType);
+  itkGetConstMacro(Pattern, PatternType);
+
+  /** Set the pattern by its name, returns false for an unknown name. */
+  bool SetPatternName( const std::string & name )
+    {
+      const char * names[] = { "sparse", "dense", "random", "shell" };
+      for ( unsigned int i = 0; i < 4; ++i )
+        {
+        if ( name == names[i] )
+          {
+          this->SetPattern( static_cast< PatternType >( i ) );
+          return true;
+          }
+        }
+      return false;
+    }
+
+protected:
+  SyntheticMaskImageSource()
+    : m_Pattern( ShellPattern )
+    {
+      m_Size.Fill( 64 );
+    }
+  ~SyntheticMaskImageSource() {}
+
+  void PrintSelf( std::ostream & os, Indent indent ) const override
+    {
+      Superclass::PrintSelf( os, indent );
+      os << indent << "Size: " << m_Size << std::endl;
+      os << indent << "Pattern: " << static_cast< int >( m_Pattern ) << std::endl;
+    }
+
+  void GenerateOutputInformation() override
+    {
+      Superclass::GenerateOutputInformation();
+
+      RegionType largestRegion;
+      largestRegion.SetSize( m_Size );
+      this->GetOutput()->SetLargestPossibleRegion( largestRegion );
+    }
+
+  static std::uint64_t Hash( std::uint64_t x )
+    {
+      // splitmix64 finalizer
+      x += 0x9e3779b97f4a7c15ULL;
+      x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+      x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebULL;
+      return x ^ ( x >> 31 );
+    }
+
+  void DynamicThreadedGenerateData( const RegionType & outputRegionForThread ) override
+    {
+      const unsigned int dimension = OutputImageType::ImageDimension;
+      const PixelType on = NumericTraits< PixelType >::OneValue();
+      const PixelType off = NumericTraits< PixelType >::ZeroValue();
+
+      double center[dimension];
+      double radius = NumericTraits< double >::max();
+      for ( unsigned int i = 0; i < dimension; ++i )
+        {
+        center[i] = 0.5 * ( m_Size[i] - 1 );
+        radius = std::min( radius, 0.4 * m_Size[i] );
+        }
+
+      ImageScanlineIterator< OutputImageType > it( this->GetOutput(), outputRegionForThread );
+      while ( !it.IsAtEnd() )
+        {
+        const typename OutputImageType::IndexType index = it.GetIndex();
+
+        // the linear offset of the pixel in the largest region
+        std::uint64_t offset = 0;
+        double lineDistance2 = 0.0;
+        for ( unsigned int i = dimension; i > 0; --i )
+          {
+          offset = offset * m_Size[i-1] + static_cast< std::uint64_t >( index[i-1] );
+          if ( i > 1 )
+            {
+            lineDistance2 += ( index[i-1] - center[i-1] ) * ( index[i-1] - center[i-1] );
+            }
+          }
+
+        IndexValueType x = index[0];
+        while ( !it.IsAtEndOfLine() )
+          {
+          bool set = false;
+          switch ( m_Pattern )
+            {
+            case SparsePattern:
+              set = ( ( Hash( offset ) & 4095 ) == 0 );
+              break;
+            case DensePattern:
+              set = true;
+              break;
+            case RandomPattern:
+              set = ( ( Hash( offset ) & 1 ) != 0 );
+              break;
+            case ShellPattern:
+              {
+              const double d = std::sqrt( lineDistance2 + ( x - center[0] ) * ( x - center[0] ) );
+              set = ( d >= radius - 1.0 && d < radius + 1.0 );
+              }
+              break;
+            }
+          it.Set( set ? on : off );
+          ++it;
+          ++x;
+          ++offset;
+          }
+        it.NextLine();
+        }
+    }
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(SyntheticMaskImageSource);
+
+  SizeType    m_Size;
+  PatternType m_Pattern;
+};
+
+} // end namespace itk
+
+#endif //itkSyntheticMaskImageSource_h